@@ -0,0 +1,316 @@
+// src/bench/BenchMain.cpp (ļ)
+// MorpheusBench: ޴ڵؽű·Ⱦ̶֡
+//  JSON ֡ʱͳ (min / median / p99)׶κʱͼϣںܱ仯Ͳ׽Ⱦع
+#include "core/BuiltinShaders.h"
+#include "core/RenderSettings.h"
+#include "core/Profiler.h"
+#include "renderer/Renderer.h"
+#include "scene/Scene.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using namespace Morpheus;
+
+struct BenchOptions {
+    std::vector<std::string> scenes;
+    std::string outputPath;        // Ϊʱд stdout
+    std::string goldenPath;        // ֮ȽϵĹϣļ
+    std::string writeGoldenPath;   // ѱεĹϣдµĻ׼
+    std::string tracePath;         // д׶ε Chrome trace
+    int frames = 120;
+    int warmupFrames = 5;
+    int hashInterval = 10;         // ÿ֡¼һͼϣ
+    Core::RenderSettings render;   // ֱʡ·Ⱦ ( --headless )
+};
+
+void PrintUsage() {
+    std::cerr <<
+        "Usage: MorpheusBench --scene <path> [--scene <path> ...] [options]\n"
+        "  --camera-path <path>    camera keyframe JSON (default: static scene camera)\n"
+        "  --size <W>x<H>          resolution (default 800x600)\n"
+        "  --frames <N>            measured frames per scene (default 120)\n"
+        "  --warmup <N>            unmeasured frames before measuring (default 5)\n"
+        "  --fps <F>               playback rate for the camera path\n"
+        "  --hash-interval <N>     hash every N-th frame (default 10)\n"
+        "  --output <path>         write the JSON report to a file instead of stdout\n"
+        "  --golden <path>         compare frame hashes against a golden file, exit 2 on mismatch\n"
+        "  --write-golden <path>   write this run's frame hashes as a golden file\n"
+        "  --trace <path>          write a Chrome trace / Perfetto JSON of the measured frames\n"
+        "  --deferred              use deferred shading for opaque objects that support it\n"
+        "  --oit                   order-independent transparency (weighted blended)\n"
+        "  --msaa                  4x multisample anti-aliasing (forward shading only)\n"
+        "  --taa                   temporal anti-aliasing (jittered projection + history reprojection)\n"
+        "  --vrs-periphery         coarser shading rate (2x2 / 4x4) towards the screen edges\n";
+}
+
+bool ParseOptions(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (Core::ParseRenderFlag(arg, options.render)) continue;
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--scene") options.scenes.push_back(value);
+        else if (arg == "--camera-path") options.render.cameraPath = value;
+        else if (arg == "--output") options.outputPath = value;
+        else if (arg == "--golden") options.goldenPath = value;
+        else if (arg == "--write-golden") options.writeGoldenPath = value;
+        else if (arg == "--trace") options.tracePath = value;
+        else if (arg == "--frames") options.frames = std::stoi(value);
+        else if (arg == "--warmup") options.warmupFrames = std::stoi(value);
+        else if (arg == "--hash-interval") options.hashInterval = std::stoi(value);
+        else if (arg == "--fps") options.render.fps = std::stof(value);
+        else if (arg == "--size") {
+            if (sscanf(value.c_str(), "%dx%d", &options.render.width, &options.render.height) != 2) {
+                std::cerr << "Invalid size: " << value << std::endl;
+                return false;
+            }
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    if (options.scenes.empty() || options.render.width <= 0 || options.render.height <= 0 ||
+        options.frames <= 0 || options.warmupFrames < 0 || options.hashInterval <= 0) {
+        return false;
+    }
+    return true;
+}
+
+// 64 λ FNV-1aɫϣ
+std::string HashFramebuffer(const Renderer::Framebuffer& framebuffer) {
+    const auto& pixels = framebuffer.GetColorBuffer();
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(pixels.data());
+    const size_t size = pixels.size() * sizeof(uint32_t);
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hash);
+    return buffer;
+}
+
+// һ ()  min / median / p99 / mean / max
+json Summarize(std::vector<float> samples) {
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        size_t index = (size_t)std::min<double>(samples.size() - 1, std::ceil(p * samples.size()) - 1);
+        return samples[index];
+    };
+    double sum = 0.0;
+    for (float s : samples) sum += s;
+    return {
+        { "min", samples.front() },
+        { "median", samples[samples.size() / 2] },
+        { "p99", percentile(0.99) },
+        { "mean", sum / samples.size() },
+        { "max", samples.back() }
+    };
+}
+
+// ȾͳƵÿ֡ƽֵ
+json StatsToJson(const Renderer::RenderStats& total, int frames) {
+    auto average = [frames](uint64_t value) { return (double)value / frames; };
+    return {
+        { "triangles_submitted", average(total.trianglesSubmitted) },
+        { "triangles_clipped", average(total.trianglesClipped) },
+        { "triangles_outside_frustum", average(total.trianglesOutsideFrustum) },
+        { "triangles_backface_culled", average(total.trianglesBackfaceCulled) },
+        { "triangles_binned", average(total.trianglesBinned) },
+        { "tile_bin_entries", average(total.tileBinEntries) },
+        { "fragments_tested", average(total.fragmentsTested) },
+        { "fragments_depth_rejected", average(total.fragmentsDepthRejected) },
+        { "fragments_shaded", average(total.fragmentsShaded) },
+        { "fragments_blended", average(total.fragmentsBlended) },
+        { "pixels_lit", average(total.pixelsLit) },
+        { "local_lights", average(total.localLights) },
+        { "tile_light_entries", average(total.tileLightEntries) }
+    };
+}
+
+// ׼ļֲͬļ
+std::string GoldenKey(const BenchOptions& options, const std::string& scenePath) {
+    const Core::RenderSettings& render = options.render;
+    return scenePath + "|" + render.cameraPath + "|" + std::to_string(render.width) + "x" + std::to_string(render.height) +
+        (render.deferredShading ? "|deferred" : "") + (render.orderIndependentTransparency ? "|oit" : "") +
+        (render.multisampling ? "|msaa" : "") + (render.temporalAA ? "|taa" : "") +
+        (render.peripheralShadingRate ? "|vrs-periphery" : "");
+}
+
+json RunScene(const BenchOptions& options, const std::string& scenePath) {
+    Scene::Scene scene = Scene::Scene::Load(scenePath);
+    Core::FrameCamera camera(options.render, scene);
+
+    Renderer::Renderer renderer(options.render.width, options.render.height);
+    Core::ApplyRenderSettings(options.render, renderer);
+
+    // Ԥȣ̡߳ڴȶ״̬ͣڵһ֡
+    for (int i = 0; i < options.warmupFrames; ++i) {
+        camera.Apply(0);
+        renderer.Render(scene);
+    }
+
+    // ֻ¼׶ε¼
+    Core::Profiler::Get().SetEnabled(!options.tracePath.empty());
+    std::vector<float> frame_ms, clear_ms, sort_ms, shadow_ms, vertex_ms, clipping_ms, binning_ms, raster_ms, light_culling_ms, lighting_ms, oit_resolve_ms, msaa_resolve_ms, taa_resolve_ms, write_back_ms;
+    json hashes = json::object();
+    Renderer::RenderStats total_stats;
+    for (int frame = 0; frame < options.frames; ++frame) {
+        // ֡Ŷǰʵʱƽ֤ÿпĻȫһ
+        camera.Apply(frame);
+
+        auto start = std::chrono::steady_clock::now();
+        renderer.Render(scene);
+        frame_ms.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        const auto& timings = renderer.GetLastFrameTimings();
+        clear_ms.push_back(timings.clearMs);
+        sort_ms.push_back(timings.sortMs);
+        shadow_ms.push_back(timings.shadowMs);
+        vertex_ms.push_back(timings.vertexShadingMs);
+        clipping_ms.push_back(timings.clippingMs);
+        binning_ms.push_back(timings.binningMs);
+        raster_ms.push_back(timings.rasterMs);
+        light_culling_ms.push_back(timings.lightCullingMs);
+        lighting_ms.push_back(timings.lightingMs);
+        oit_resolve_ms.push_back(timings.oitResolveMs);
+        msaa_resolve_ms.push_back(timings.multisampleResolveMs);
+        taa_resolve_ms.push_back(timings.temporalResolveMs);
+        write_back_ms.push_back(timings.writeBackMs);
+
+        total_stats += renderer.GetLastFrameStats();
+
+        if (frame % options.hashInterval == 0 || frame == options.frames - 1) {
+            hashes[std::to_string(frame)] = HashFramebuffer(*renderer.GetFramebuffer());
+        }
+    }
+
+    return {
+        { "scene", scenePath },
+        { "frames", options.frames },
+        { "frame_ms", Summarize(frame_ms) },
+        { "stages_ms", {
+            { "clear", Summarize(clear_ms) },
+            { "sort", Summarize(sort_ms) },
+            { "shadows", Summarize(shadow_ms) },
+            { "vertex_shading", Summarize(vertex_ms) },
+            { "clipping", Summarize(clipping_ms) },
+            { "binning", Summarize(binning_ms) },
+            { "raster", Summarize(raster_ms) },
+            { "light_culling", Summarize(light_culling_ms) },
+            { "lighting", Summarize(lighting_ms) },
+            { "oit_resolve", Summarize(oit_resolve_ms) },
+            { "msaa_resolve", Summarize(msaa_resolve_ms) },
+            { "taa_resolve", Summarize(taa_resolve_ms) },
+            { "write_back", Summarize(write_back_ms) }
+        } },
+        { "stats_per_frame", StatsToJson(total_stats, options.frames) },
+        { "hashes", hashes }
+    };
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        Core::RegisterBuiltinShaders();
+
+        json golden = json::object();
+        if (!options.goldenPath.empty()) {
+            std::ifstream file(options.goldenPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open golden file: " + options.goldenPath);
+            }
+            golden = json::parse(file);
+        }
+
+        json report = {
+            { "resolution", { options.render.width, options.render.height } },
+            { "deferred_shading", options.render.deferredShading },
+            { "order_independent_transparency", options.render.orderIndependentTransparency },
+            { "multisampling", options.render.multisampling },
+            { "temporal_aa", options.render.temporalAA },
+            { "peripheral_shading_rate", options.render.peripheralShadingRate },
+            { "camera_path", options.render.cameraPath },
+            { "warmup_frames", options.warmupFrames },
+            { "scenes", json::array() }
+        };
+        json new_golden = golden;
+        bool all_match = true;
+
+        for (const auto& scene_path : options.scenes) {
+            json result = RunScene(options, scene_path);
+            const std::string key = GoldenKey(options, scene_path);
+
+            if (!options.goldenPath.empty()) {
+                if (!golden.contains(key)) {
+                    result["golden"] = "missing";
+                    all_match = false;
+                }
+                else {
+                    // ֡Ƚϣгһµ֡
+                    json mismatches = json::array();
+                    for (const auto& [frame, hash] : result["hashes"].items()) {
+                        if (!golden[key].contains(frame) || golden[key][frame] != hash) mismatches.push_back(std::stoi(frame));
+                    }
+                    result["golden"] = mismatches.empty() ? "match" : "mismatch";
+                    if (!mismatches.empty()) {
+                        result["golden_mismatched_frames"] = mismatches;
+                        all_match = false;
+                    }
+                }
+            }
+            new_golden[key] = result["hashes"];
+            report["scenes"].push_back(result);
+        }
+
+        if (!options.tracePath.empty()) {
+            Core::Profiler::Get().WriteChromeTrace(options.tracePath);
+        }
+
+        if (!options.writeGoldenPath.empty()) {
+            std::ofstream file(options.writeGoldenPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open golden file: " + options.writeGoldenPath);
+            }
+            file << new_golden.dump(2) << std::endl;
+            if (!file) {
+                throw std::runtime_error("Failed to write golden file: " + options.writeGoldenPath);
+            }
+        }
+
+        if (options.outputPath.empty()) {
+            std::cout << report.dump(2) << std::endl;
+        }
+        else {
+            std::ofstream file(options.outputPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open output file: " + options.outputPath);
+            }
+            file << report.dump(2) << std::endl;
+        }
+        return all_match ? 0 : 2;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "An error occurred: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -6,30 +6,15 @@
 #include "../scene/Scene.h"
 #include "InputManager.h"  
 #include "CameraController.h" // <--- 
-#include "../renderer/shaders/UnlitShader.h" // <--- Ҫע Shader
-#include "../renderer/shaders/BlinnPhongShader.h" // <---  BlinnPhong Shader
-
-// ---  Application Ա֮ǰһ ---
-void RegisterShaders() {
-    Morpheus::Scene::Scene::RegisterShader("Unlit", []() {
-        return std::make_shared<Morpheus::Renderer::UnlitShader>();
-        });
-    // ---  Blinn-Phong ע ---
-    Morpheus::Scene::Scene::RegisterShader("BlinnPhong", []() {
-        return std::make_shared<Morpheus::Renderer::BlinnPhongShader>();
-        });
-    // δע PBR Shader 
-    // Morpheus::Scene::Scene::RegisterShader("PBR", []() { 
-    //     return std::make_shared<Morpheus::Renderer::PBRShader>(); 
-    // });
-}
+#include "BuiltinShaders.h"
+#include "Profiler.h"
 
 namespace Morpheus::Core {
 
-    Application::Application(const std::string& title, int width, int height)
-        : m_title(title), m_width(width), m_height(height) {
+    Application::Application(const std::string& title, int width, int height, const std::string& scenePath)
+        : m_title(title), m_width(width), m_height(height), m_scenePath(scenePath) {
         // --- гʼ֮ǰע Shaders ---
-        RegisterShaders();
+        RegisterBuiltinShaders();
         Initialize();
     }
 
@@ -50,14 +35,18 @@ namespace Morpheus::Core {
         m_sdlRenderer = SDL_CreateRenderer(m_window, -1, SDL_RENDERER_ACCELERATED);
         m_screenTexture = SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, m_width, m_height);
 
+        // ʱ¼дλ壬СģʽĬϿ
+        Profiler::Get().SetEnabled(true);
+
         m_morpheusRenderer = std::make_unique<Renderer::Renderer>(m_width, m_height);
         m_cameraController = std::make_unique<CameraController>(); // <--- 
         // --- ޸ģ ---
         try {
-            m_scene = std::make_unique<Scene::Scene>(Scene::Scene::Load("assets/scenes/test_scene.json"));
+            m_scene = std::make_unique<Scene::Scene>(Scene::Scene::Load(m_scenePath));
             // ʼͶӰ
             m_scene->GetCamera().SetPerspective(45.0f, (float)m_width / (float)m_height, 0.1f, 100.0f);
-
+            // ༭ļ
+            m_scene->EnableHotReload();
         }
         catch (const std::exception& e) {
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Scene Load Error", e.what(), m_window);
@@ -104,7 +93,15 @@ namespace Morpheus::Core {
     }
 
     void Application::Update(float deltaTime) {
+        bool trace_key_down = InputManager::Get().IsKeyPressed(SDL_SCANCODE_F9);
+        if (trace_key_down && !m_traceKeyWasDown) {
+            Profiler::Get().WriteChromeTrace("morpheus_trace.json");
+        }
+        m_traceKeyWasDown = trace_key_down;
+
         if (m_scene) {
+            // ֮֡任Ѿ¼غõԴ
+            m_scene->PollHotReload();
             //  deltaTime ݸʵ֡޹صƶ
             m_cameraController->Update(&m_scene->GetCamera(), deltaTime);
         }
@@ -128,6 +125,7 @@ namespace Morpheus::Core {
         // 3.  "blit" 뱣ֲ
         auto framebuffer = m_morpheusRenderer->GetFramebuffer();
         if (framebuffer) { // üӸָ
+            MORPHEUS_PROFILE_SCOPE("Present");
             SDL_UpdateTexture(m_screenTexture, NULL, framebuffer->GetPixelData(), framebuffer->GetWidth() * sizeof(uint32_t));
             SDL_RenderClear(m_sdlRenderer);
             SDL_RenderCopy(m_sdlRenderer, m_screenTexture, NULL, NULL);
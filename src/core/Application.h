@@ -15,9 +15,11 @@ namespace Morpheus::Scene { class Camera; class Scene; } // <--- 
 namespace Morpheus::Core {
     class Application {
     public:
-        Application(const std::string& title, int width, int height);
+        Application(const std::string& title, int width, int height, const std::string& scenePath = "assets/scenes/test_scene.json");
         ~Application();
         void Run();
+        //  Run ֮ǰȾ (е --oit)
+        Renderer::Renderer& GetRenderer() { return *m_morpheusRenderer; }
     private:
         void Initialize();
         void HandleEvents();
@@ -28,6 +30,7 @@ namespace Morpheus::Core {
         bool m_isRunning = true;
         int m_width, m_height;
         std::string m_title;
+        std::string m_scenePath;
 
         SDL_Window* m_window = nullptr;
         SDL_Renderer* m_sdlRenderer = nullptr;
@@ -43,5 +46,8 @@ namespace Morpheus::Core {
         float m_fps = 0.0f;
         float m_frameTime = 0.0f;
         float m_fpsTimer = 0.0f;
+
+        //  F9 ʱ Chrome trace (ֻڰµһ֡)
+        bool m_traceKeyWasDown = false;
     };
 }
@@ -0,0 +1,21 @@
+// src/core/BuiltinShaders.cpp (ļ)
+#include "BuiltinShaders.h"
+#include "../scene/Scene.h"
+#include "../renderer/shaders/UnlitShader.h" // <--- Ҫע Shader
+#include "../renderer/shaders/BlinnPhongShader.h" // <---  BlinnPhong Shader
+
+namespace Morpheus::Core {
+    void RegisterBuiltinShaders() {
+        Scene::Scene::RegisterShader("Unlit", []() {
+            return std::make_shared<Renderer::UnlitShader>();
+            });
+        // ---  Blinn-Phong ע ---
+        Scene::Scene::RegisterShader("BlinnPhong", []() {
+            return std::make_shared<Renderer::BlinnPhongShader>();
+            });
+        // δע PBR Shader 
+        // Scene::Scene::RegisterShader("PBR", []() { 
+        //     return std::make_shared<Renderer::PBRShader>(); 
+        // });
+    }
+}
@@ -0,0 +1,7 @@
+// src/core/BuiltinShaders.h (ļ)
+#pragma once
+
+namespace Morpheus::Core {
+    // õ Shader עᵽ Scene  Shader  (ģʽȾͻ׼Թ)
+    void RegisterBuiltinShaders();
+}
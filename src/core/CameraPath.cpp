@@ -0,0 +1,73 @@
+// src/core/CameraPath.cpp (ļ)
+#include "CameraPath.h"
+#include "../scene/Camera.h"
+#include "../math/Common.h"
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace Morpheus::Core {
+
+    CameraPath CameraPath::Load(const std::string& filepath) {
+        std::ifstream file(filepath);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open camera path: " + filepath);
+        }
+        json data = json::parse(file);
+
+        CameraPath path;
+        path.m_fps = data.value("fps", path.m_fps);
+        path.m_fov = data.value("fov", path.m_fov);
+        path.m_near = data.value("near", path.m_near);
+        path.m_far = data.value("far", path.m_far);
+        // ֡ʱ frame / fpsfps <= 0 ÿһ֡ʱ䶼 inf/NaN
+        if (!(path.m_fps > 0.0f)) {
+            throw std::runtime_error("Camera path fps must be positive: " + filepath);
+        }
+
+        for (const auto& key_data : data.at("keyframes")) {
+            CameraKeyframe key;
+            key.time = key_data.value("time", 0.0f);
+            key.position = { key_data["position"][0], key_data["position"][1], key_data["position"][2] };
+            key.focalPoint = { key_data["focal_point"][0], key_data["focal_point"][1], key_data["focal_point"][2] };
+            path.m_keyframes.push_back(key);
+        }
+        if (path.m_keyframes.empty()) {
+            throw std::runtime_error("Camera path has no keyframes: " + filepath);
+        }
+        std::stable_sort(path.m_keyframes.begin(), path.m_keyframes.end(),
+            [](const CameraKeyframe& a, const CameraKeyframe& b) { return a.time < b.time; });
+        return path;
+    }
+
+    void CameraPath::Apply(Scene::Camera& camera, float time, float aspect) const {
+        camera.SetPerspective(m_fov, aspect, m_near, m_far);
+        if (m_keyframes.empty()) return;
+
+        // ҵ time ڵ [prev, next]
+        auto next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), time,
+            [](float t, const CameraKeyframe& key) { return t < key.time; });
+        Math::Vector3f position, focal_point;
+        if (next == m_keyframes.begin()) {
+            position = next->position;
+            focal_point = next->focalPoint;
+        }
+        else if (next == m_keyframes.end()) {
+            position = m_keyframes.back().position;
+            focal_point = m_keyframes.back().focalPoint;
+        }
+        else {
+            const CameraKeyframe& prev = *(next - 1);
+            float span = next->time - prev.time;
+            float t = span > 0.0f ? (time - prev.time) / span : 1.0f;
+            position = Math::Lerp(prev.position, next->position, t);
+            focal_point = Math::Lerp(prev.focalPoint, next->focalPoint, t);
+        }
+        camera.SetPosition(position);
+        camera.SetFocalPoint(focal_point);
+        camera.UpdateViewMatrix();
+    }
+}
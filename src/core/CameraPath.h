@@ -0,0 +1,44 @@
+// src/core/CameraPath.h (ļ)
+#pragma once
+#include "../math/Vector.h"
+#include <vector>
+#include <string>
+
+namespace Morpheus::Scene { class Camera; }
+
+namespace Morpheus::Core {
+
+    // ؼ֡
+    struct CameraKeyframe {
+        float time = 0.0f; // 
+        Math::Vector3f position;
+        Math::Vector3f focalPoint;
+    };
+
+    // ű·Ⱦͻ׼
+    // JSON ʽ:
+    // {
+    //   "fps": 30,                       (ѡ)
+    //   "fov": 45, "near": 0.1, "far": 100, (ѡ)
+    //   "keyframes": [ { "time": 0.0, "position": [0, 2, 5], "focal_point": [0, 0, 0] }, ... ]
+    // }
+    // ؼ֮֡ԲֵΧʱͣ/βؼ֡
+    class CameraPath {
+    public:
+        static CameraPath Load(const std::string& filepath);
+
+        bool IsEmpty() const { return m_keyframes.empty(); }
+        float GetDuration() const { return m_keyframes.empty() ? 0.0f : m_keyframes.back().time; }
+        float GetFps() const { return m_fps; }
+
+        // · time ʱ̵״̬Ӧõ (ͶӰ)
+        void Apply(Scene::Camera& camera, float time, float aspect) const;
+
+    private:
+        std::vector<CameraKeyframe> m_keyframes;
+        float m_fps = 30.0f;
+        float m_fov = 45.0f;
+        float m_near = 0.1f;
+        float m_far = 100.0f;
+    };
+}
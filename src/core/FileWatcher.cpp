@@ -0,0 +1,102 @@
+// src/core/FileWatcher.cpp (ļ)
+#include "FileWatcher.h"
+#include <set>
+#include <SDL.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace Morpheus::Core {
+
+    // ѯģʽɨ֮Сÿ֡ȥ stat ļ
+    constexpr auto FILE_WATCHER_SCAN_INTERVAL = std::chrono::milliseconds(250);
+
+    std::string NormalizeWatchPath(const std::filesystem::path& path) {
+        return path.lexically_normal().generic_string();
+    }
+
+    FileWatcher::FileWatcher() {
+        m_lastScan = std::chrono::steady_clock::now();
+#ifdef __linux__
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0) {
+            SDL_Log("Warning: inotify unavailable, falling back to polling file timestamps.");
+        }
+#endif
+    }
+
+    FileWatcher::~FileWatcher() {
+#ifdef __linux__
+        if (m_inotifyFd >= 0) close(m_inotifyFd);
+#endif
+    }
+
+    void FileWatcher::Watch(const std::string& path) {
+        std::string key = NormalizeWatchPath(path);
+        if (m_watched.count(key)) return;
+        m_watched[key] = path;
+
+        std::error_code ec;
+        m_lastWriteTimes[key] = std::filesystem::last_write_time(path, ec);
+
+#ifdef __linux__
+        if (m_inotifyFd >= 0) {
+            std::string dir = NormalizeWatchPath(std::filesystem::path(key).parent_path());
+            if (dir.empty()) dir = ".";
+            if (!m_watchDescriptors.count(dir)) {
+                int wd = inotify_add_watch(m_inotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+                if (wd < 0) {
+                    SDL_Log("Warning: Could not watch directory '%s'.", dir.c_str());
+                    return;
+                }
+                m_watchDescriptors[dir] = wd;
+                m_watchDirs[wd] = dir;
+            }
+        }
+#endif
+    }
+
+    std::vector<std::string> FileWatcher::Poll() {
+        std::set<std::string> changed;
+
+#ifdef __linux__
+        if (m_inotifyFd >= 0) {
+            alignas(inotify_event) char buffer[4096];
+            for (;;) {
+                ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+                if (length <= 0) break; // EAGAIN: ûи¼
+
+                for (ssize_t offset = 0; offset < length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += sizeof(inotify_event) + event->len;
+
+                    auto dir = m_watchDirs.find(event->wd);
+                    if (dir == m_watchDirs.end() || event->len == 0) continue;
+                    std::string key = NormalizeWatchPath(std::filesystem::path(dir->second) / event->name);
+                    auto it = m_watched.find(key);
+                    if (it != m_watched.end()) changed.insert(it->second);
+                }
+            }
+            return std::vector<std::string>(changed.begin(), changed.end());
+        }
+#endif
+
+        // --- ˷Ƚ޸ʱ ---
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_lastScan < FILE_WATCHER_SCAN_INTERVAL) return {};
+        m_lastScan = now;
+
+        for (auto& [key, last_time] : m_lastWriteTimes) {
+            std::error_code ec;
+            auto time = std::filesystem::last_write_time(m_watched[key], ec);
+            if (!ec && time != last_time) {
+                last_time = time;
+                changed.insert(m_watched[key]);
+            }
+        }
+        return std::vector<std::string>(changed.begin(), changed.end());
+    }
+}
@@ -0,0 +1,41 @@
+// src/core/FileWatcher.h (ļ)
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <filesystem>
+#include <chrono>
+
+namespace Morpheus::Core {
+
+    // һļ޸
+    // Linux ʹ inotify ļڵĿ¼ (༭ "дʱļ" ķʽ棬ֱӼļᶪ¼)
+    // ƽ̨˻ΪڱȽļ޸ʱ
+    class FileWatcher {
+    public:
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // ʼһļ (ظǰȫ)
+        void Watch(const std::string& path);
+
+        // ϴε޸Ĺļ (ʹ Watch ʱ·ȥ)
+        std::vector<std::string> Poll();
+
+    private:
+        // 淶֮· -> Watch ʱԭʼ·
+        std::map<std::string, std::string> m_watched;
+        // ޸ʱѯģʽ¼¼ϴ޸ʱ
+        std::map<std::string, std::filesystem::file_time_type> m_lastWriteTimes;
+        std::chrono::steady_clock::time_point m_lastScan;
+
+#ifdef __linux__
+        int m_inotifyFd = -1;
+        std::map<int, std::string> m_watchDirs;       // inotify watch descriptor -> Ŀ¼
+        std::map<std::string, int> m_watchDescriptors; // Ŀ¼ -> inotify watch descriptor
+#endif
+    };
+}
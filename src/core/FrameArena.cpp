@@ -0,0 +1,56 @@
+// src/core/FrameArena.cpp (ļ)
+#include "FrameArena.h"
+#include <algorithm>
+
+namespace Morpheus::Core {
+
+    FrameArena::FrameArena(size_t blockSize)
+        : m_blockSize(blockSize) {
+    }
+
+    void* FrameArena::AllocateFromNextBlock(size_t size, size_t alignment) {
+        // ǰŲ£ȳԺѾڵĿ (һ֡µ)¿
+        for (size_t next = m_currentBlock + 1; next < m_blocks.size(); ++next) {
+            Block& block = m_blocks[next];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            uintptr_t aligned = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            if (aligned + size <= base + block.size) {
+                m_currentBlock = next;
+                m_offset = aligned + size - base;
+                return reinterpret_cast<void*>(aligned);
+            }
+        }
+
+        Block block;
+        block.size = std::max(m_blockSize, size + alignment);
+        block.data.reset(new std::byte[block.size]); // Ҫ
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        uintptr_t aligned = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+        m_blocks.push_back(std::move(block));
+        m_currentBlock = m_blocks.size() - 1;
+        m_offset = aligned + size - base;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void FrameArena::Reset() {
+        // һ֡õ˶飺ϲһȫĿ飬һֻ֡ͬҪһ
+        if (m_blocks.size() > 1) {
+            size_t capacity = GetCapacity();
+            m_blocks.clear();
+            Block block;
+            block.size = capacity;
+            block.data.reset(new std::byte[capacity]);
+            m_blocks.push_back(std::move(block));
+        }
+        m_currentBlock = 0;
+        m_offset = 0;
+        m_bytesUsed = 0;
+    }
+
+    size_t FrameArena::GetCapacity() const {
+        size_t capacity = 0;
+        for (const auto& block : m_blocks) capacity += block.size;
+        return capacity;
+    }
+}
@@ -0,0 +1,80 @@
+// src/core/FrameArena.h (ļ)
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Morpheus::Core {
+
+    // ֡Է (bump allocator)
+    // ֻƶһƫĶ󲻻ᱻͷţReset() һԻڴ档
+    // һ֡˶ڴʱReset() Ǻϲһ㹻Ŀ飬֮ȶ֡ϵͳڴ档
+    // ̰߳ȫģÿ߳ (ÿ) ʹԼ FrameArena
+    class FrameArena {
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena(FrameArena&&) noexcept = default;
+        FrameArena& operator=(FrameArena&&) noexcept = default;
+
+        //  size ֽڣ alignment  (alignment  2 )
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        // 䲢һᱻãֻƽ
+        template<typename T, typename... Args>
+        T* New(Args&&... args) {
+            static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+            return new (Allocate(sizeof(T), alignof(T))) T{ std::forward<Args>(args)... };
+        }
+
+        //  count ֵʼԪ
+        template<typename T>
+        T* NewArray(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+            T* data = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+            for (size_t i = 0; i < count; ++i) new (data + i) T();
+            return data;
+        }
+
+        // ձ֡еķ (֮ǰصָȫʧЧ)
+        void Reset();
+
+        size_t GetBytesUsed() const { return m_bytesUsed; }
+        size_t GetCapacity() const;
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size = 0;
+        };
+        void* AllocateFromNextBlock(size_t size, size_t alignment);
+
+        std::vector<Block> m_blocks;
+        size_t m_blockSize;
+        size_t m_currentBlock = 0; // ʹõĿ
+        size_t m_offset = 0;       // ǰѾõֽ
+        size_t m_bytesUsed = 0;    // ֽ֡ ()
+    };
+
+    inline void* FrameArena::Allocate(size_t size, size_t alignment) {
+        m_bytesUsed += size;
+        if (m_currentBlock < m_blocks.size()) {
+            Block& block = m_blocks[m_currentBlock];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            uintptr_t aligned = (base + m_offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            if (aligned + size <= base + block.size) {
+                m_offset = aligned + size - base;
+                return reinterpret_cast<void*>(aligned);
+            }
+        }
+        return AllocateFromNextBlock(size, alignment);
+    }
+}
@@ -0,0 +1,132 @@
+// src/core/FrameWriter.cpp (ļ)
+#include "FrameWriter.h"
+#include "../renderer/Framebuffer.h"
+#include <cstdio>
+#include <vector>
+#include <stdexcept>
+#include <filesystem>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+namespace Morpheus::Core {
+
+    // 0xAARRGGBB -> յ RGB ֽ
+    std::vector<unsigned char> ToRGB(const uint32_t* pixels, size_t count) {
+        std::vector<unsigned char> rgb(count * 3);
+        for (size_t i = 0; i < count; ++i) {
+            rgb[i * 3 + 0] = static_cast<unsigned char>(pixels[i] >> 16);
+            rgb[i * 3 + 1] = static_cast<unsigned char>(pixels[i] >> 8);
+            rgb[i * 3 + 2] = static_cast<unsigned char>(pixels[i]);
+        }
+        return rgb;
+    }
+
+    bool HasSuffix(const std::string& path, const std::string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    void WriteRaw(const uint32_t* pixels, size_t count, FILE* file) {
+        if (fwrite(pixels, sizeof(uint32_t), count, file) != count) {
+            throw std::runtime_error("Failed to write raw frame.");
+        }
+    }
+
+    void WriteFrame(const Renderer::Framebuffer& framebuffer, const std::string& path) {
+        WriteImage(framebuffer.GetPixelData(), framebuffer.GetWidth(), framebuffer.GetHeight(), path);
+    }
+
+    void WriteImage(const uint32_t* pixels, int width, int height, const std::string& path) {
+        const size_t count = static_cast<size_t>(width) * height;
+
+        if (path == "-") {
+#ifdef _WIN32
+            _setmode(_fileno(stdout), _O_BINARY);
+#endif
+            WriteRaw(pixels, count, stdout);
+            fflush(stdout);
+            return;
+        }
+
+        if (!HasSuffix(path, ".png") && !HasSuffix(path, ".ppm") && !HasSuffix(path, ".raw")) {
+            throw std::runtime_error("Unsupported output format (expected .png, .ppm, .raw or -): " + path);
+        }
+
+        // ԶĿ¼
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) {
+            std::error_code ec;
+            std::filesystem::create_directories(parent, ec);
+        }
+
+        if (HasSuffix(path, ".png")) {
+            auto rgb = ToRGB(pixels, count);
+            if (!stbi_write_png(path.c_str(), width, height, 3, rgb.data(), width * 3)) {
+                throw std::runtime_error("Failed to write PNG: " + path);
+            }
+            return;
+        }
+
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("Failed to open output file: " + path);
+        }
+        if (HasSuffix(path, ".ppm")) {
+            auto rgb = ToRGB(pixels, count);
+            fprintf(file, "P6\n%d %d\n255\n", width, height);
+            size_t written = fwrite(rgb.data(), 1, rgb.size(), file);
+            fclose(file);
+            if (written != rgb.size()) {
+                throw std::runtime_error("Failed to write PPM: " + path);
+            }
+            return;
+        }
+        try {
+            WriteRaw(pixels, count, file);
+        }
+        catch (...) {
+            fclose(file);
+            throw;
+        }
+        fclose(file);
+    }
+
+    std::string FormatFramePath(const std::string& pattern, int frameIndex) {
+        // ·Уֱӵ printf ʽԼչΨһ %d / %0Ndֻ %%
+        std::string result;
+        bool has_frame = false;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            if (pattern[i] != '%') {
+                result += pattern[i];
+                continue;
+            }
+            if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+                result += '%';
+                ++i;
+                continue;
+            }
+            size_t j = i + 1;
+            const bool zero_pad = j < pattern.size() && pattern[j] == '0';
+            if (zero_pad) ++j;
+            size_t width = 0;
+            while (j < pattern.size() && pattern[j] >= '0' && pattern[j] <= '9' && width < 100) {
+                width = width * 10 + (pattern[j] - '0');
+                ++j;
+            }
+            if (has_frame || j >= pattern.size() || pattern[j] != 'd' || width >= 100) {
+                throw std::runtime_error("Invalid frame path pattern (expected one %d or %0Nd, use %% for a literal %): " + pattern);
+            }
+            std::string number = std::to_string(frameIndex);
+            if (number.size() < width) number.insert(0, width - number.size(), zero_pad ? '0' : ' ');
+            result += number;
+            has_frame = true;
+            i = j;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,24 @@
+// src/core/FrameWriter.h (ļ)
+#pragma once
+#include <string>
+#include <cstdint>
+
+namespace Morpheus::Renderer { class Framebuffer; }
+
+namespace Morpheus::Core {
+
+    //  Framebuffer ɫд̻׼ʽչ:
+    //   .png  8 λ RGB PNG
+    //   .ppm   PPM (P6)
+    //   .raw  ԭʼ 32 λ (ڴеֽ˳ B, G, R, A)
+    //   "-"   ԭʼд stdoutֱӹܵ ffmpeg:
+    //         ffmpeg -f rawvideo -pix_fmt bgra -s WxH -r 30 -i - out.mp4
+    // ʧʱ׳ std::runtime_error
+    void WriteFrame(const Renderer::Framebuffer& framebuffer, const std::string& path);
+    // ͬϣд 0xAARRGGBB  ( Overdraw ͼ)
+    void WriteImage(const uint32_t* pixels, int width, int height, const std::string& path);
+
+    // ֡չ·еռλ "frames/frame_%04d.png"
+    // һ %d  %0Nd%% ʾ % % ÷׳ std::runtime_error
+    std::string FormatFramePath(const std::string& pattern, int frameIndex);
+}
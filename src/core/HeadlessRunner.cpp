@@ -0,0 +1,76 @@
+// src/core/HeadlessRunner.cpp (ļ)
+#include "HeadlessRunner.h"
+#include "BuiltinShaders.h"
+#include "FrameWriter.h"
+#include "Profiler.h"
+#include "../renderer/Renderer.h"
+#include "../scene/Scene.h"
+#include <chrono>
+#include <SDL.h>
+
+namespace Morpheus::Core {
+
+    HeadlessRunner::HeadlessRunner(const HeadlessOptions& options)
+        : m_options(options) {
+    }
+
+    int HeadlessRunner::Run() {
+        // ·ģ岻Ϸʱڼس֮ǰͱ (׳ std::runtime_error)
+        FormatFramePath(m_options.outputPattern, 0);
+        if (!m_options.overdrawPattern.empty()) FormatFramePath(m_options.overdrawPattern, 0);
+
+        RegisterBuiltinShaders();
+
+        Scene::Scene scene = Scene::Scene::Load(m_options.scenePath);
+        FrameCamera camera(m_options.render, scene);
+
+        Renderer::Renderer renderer(m_options.render.width, m_options.render.height);
+        Profiler::Get().SetEnabled(!m_options.tracePath.empty());
+        renderer.GetFramebuffer()->SetOverdrawEnabled(!m_options.overdrawPattern.empty());
+        ApplyRenderSettings(m_options.render, renderer);
+
+        // ־ stderr (SDL_Log)stdout ԭʼ֡
+        for (int frame = 0; frame < m_options.frameCount; ++frame) {
+            auto start = std::chrono::steady_clock::now();
+
+            camera.Apply(frame);
+            renderer.Render(scene);
+
+            auto end = std::chrono::steady_clock::now();
+            float ms = std::chrono::duration<float, std::milli>(end - start).count();
+
+            std::string output_path = FormatFramePath(m_options.outputPattern, frame);
+            {
+                MORPHEUS_PROFILE_SCOPE("Present");
+                WriteFrame(*renderer.GetFramebuffer(), output_path);
+            }
+            SDL_Log("Frame %d/%d rendered in %.2f ms -> %s", frame + 1, m_options.frameCount, ms, output_path.c_str());
+
+            if (!m_options.overdrawPattern.empty()) {
+                const auto& framebuffer = *renderer.GetFramebuffer();
+                WriteImage(framebuffer.GetOverdrawHeatmap().data(), framebuffer.GetWidth(), framebuffer.GetHeight(),
+                    FormatFramePath(m_options.overdrawPattern, frame));
+            }
+            if (m_options.printStats) {
+                const auto& stats = renderer.GetLastFrameStats();
+                SDL_Log("  triangles: %llu submitted, %llu clipped, %llu outside, %llu back-face culled, %llu binned (%llu tile entries)",
+                    (unsigned long long)stats.trianglesSubmitted, (unsigned long long)stats.trianglesClipped,
+                    (unsigned long long)stats.trianglesOutsideFrustum, (unsigned long long)stats.trianglesBackfaceCulled,
+                    (unsigned long long)stats.trianglesBinned, (unsigned long long)stats.tileBinEntries);
+                SDL_Log("  fragments: %llu tested, %llu depth-rejected, %llu shaded, %llu blended; packets per tile: max %u, mean %.1f",
+                    (unsigned long long)stats.fragmentsTested, (unsigned long long)stats.fragmentsDepthRejected,
+                    (unsigned long long)stats.fragmentsShaded, (unsigned long long)stats.fragmentsBlended,
+                    stats.maxPacketsPerTile, stats.meanPacketsPerTile);
+                if (stats.localLights > 0) {
+                    SDL_Log("  local lights: %llu, %llu tile light entries",
+                        (unsigned long long)stats.localLights, (unsigned long long)stats.tileLightEntries);
+                }
+            }
+        }
+
+        if (!m_options.tracePath.empty() && !Profiler::Get().WriteChromeTrace(m_options.tracePath)) {
+            return 1;
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,30 @@
+// src/core/HeadlessRunner.h (ļ)
+#pragma once
+#include "RenderSettings.h"
+#include <string>
+
+namespace Morpheus::Core {
+
+    // Ⱦ (Ӧ --headless ģʽ)
+    struct HeadlessOptions {
+        std::string scenePath = "assets/scenes/test_scene.json";
+        std::string outputPattern = "frame_%04d.png"; //  FrameWriter.h"-" ʾԭʼд stdout
+        int frameCount = 1;
+        std::string tracePath;                     // Ϊʱ¼ʱ¼ڽд Chrome trace
+        std::string overdrawPattern;               // ΪʱΪÿ֡д Overdraw ͼ (ʽͬ outputPattern)
+        bool printStats = false;                   // ÿ֡Ⱦͳƴӡ־
+        RenderSettings render;                     // ֱʡ·Ⱦ ( MorpheusBench )
+    };
+
+    // ڡʼ SDL ƵϵͳȾ
+    // س·֡Ⱦ Framebufferÿһ֡д̻ stdout
+    class HeadlessRunner {
+    public:
+        explicit HeadlessRunner(const HeadlessOptions& options);
+        // ؽ˳
+        int Run();
+
+    private:
+        HeadlessOptions m_options;
+    };
+}
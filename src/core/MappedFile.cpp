@@ -0,0 +1,93 @@
+// src/core/MappedFile.cpp (ļ)
+#include "MappedFile.h"
+#include <atomic>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Morpheus::Core {
+
+    std::shared_ptr<MappedFile> MappedFile::Open(const std::string& filepath) {
+        // 캯˽еģ make_shared
+        std::shared_ptr<MappedFile> file(new MappedFile());
+
+#ifdef _WIN32
+        HANDLE handle = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+        file->m_fileHandle = handle;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(handle, &size)) {
+            return nullptr;
+        }
+        file->m_size = static_cast<size_t>(size.QuadPart);
+        if (file->m_size == 0) {
+            return file; // ļ޷ӳ䣬ֱӷһͼ
+        }
+
+        HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            return nullptr;
+        }
+        file->m_mappingHandle = mapping;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            return nullptr;
+        }
+        file->m_data = static_cast<const unsigned char*>(view);
+#else
+        int fd = open(filepath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return nullptr;
+        }
+        file->m_fd = fd;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            return nullptr;
+        }
+        file->m_size = static_cast<size_t>(st.st_size);
+        if (file->m_size == 0) {
+            return file;
+        }
+
+        void* view = mmap(nullptr, file->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            return nullptr;
+        }
+        file->m_data = static_cast<const unsigned char*>(view);
+#endif
+        return file;
+    }
+
+    MappedFile::~MappedFile() {
+#ifdef _WIN32
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mappingHandle) CloseHandle(m_mappingHandle);
+        if (m_fileHandle) CloseHandle(m_fileHandle);
+#else
+        if (m_data) munmap(const_cast<unsigned char*>(m_data), m_size);
+        if (m_fd >= 0) close(m_fd);
+#endif
+    }
+
+    std::string MakeTempPath(const std::string& path) {
+        static std::atomic<unsigned> counter{ 0 };
+#ifdef _WIN32
+        const unsigned long pid = GetCurrentProcessId();
+#else
+        const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+        return path + "." + std::to_string(pid) + "." + std::to_string(counter++) + ".tmp";
+    }
+}
@@ -0,0 +1,40 @@
+// src/core/MappedFile.h (ļ)
+#pragma once
+#include <string>
+#include <memory>
+#include <cstddef>
+
+namespace Morpheus::Core {
+
+    // ֻڴӳļ
+    // Windows ʹ CreateFileMapping/MapViewOfFileƽ̨ʹ mmap
+    // ļݰɲϵͳҳӳͬһļʱͬһڴ
+    class MappedFile {
+    public:
+        // 򿪲ӳļʧʱ nullptr
+        static std::shared_ptr<MappedFile> Open(const std::string& filepath);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const unsigned char* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+    private:
+        MappedFile() = default;
+
+        const unsigned char* m_data = nullptr;
+        size_t m_size = 0;
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#else
+        int m_fd = -1;
+#endif
+    };
+
+    //  path ͬĿ¼̺źŵʱļд rename  path
+    // ̻߳ͬʱͬһļʱдģҲῴдһļ
+    std::string MakeTempPath(const std::string& path);
+}
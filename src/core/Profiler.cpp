@@ -0,0 +1,75 @@
+// src/core/Profiler.cpp (ļ)
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <SDL.h>
+
+namespace Morpheus::Core {
+
+    Profiler& Profiler::Get() {
+        static Profiler instance; // Meyers' Singleton
+        return instance;
+    }
+
+    Profiler::Profiler()
+        : m_epoch(std::chrono::steady_clock::now()) {
+    }
+
+    Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+        //  Profiler У߳˳¼Ȼ
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            auto new_buffer = std::make_unique<ThreadBuffer>();
+            new_buffer->events.resize(EVENTS_PER_THREAD);
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+            new_buffer->threadIndex = static_cast<uint32_t>(m_buffers.size());
+            buffer = new_buffer.get();
+            m_buffers.push_back(std::move(new_buffer));
+        }
+        return *buffer;
+    }
+
+    void Profiler::Record(const char* name, int64_t startNs, int64_t endNs, int64_t arg) {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        uint64_t index = buffer.count.load(std::memory_order_relaxed);
+        buffer.events[index & (EVENTS_PER_THREAD - 1)] = { name, startNs, endNs - startNs, arg, m_frame.load(std::memory_order_relaxed) };
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+
+    bool Profiler::WriteChromeTrace(const std::string& filepath) {
+        FILE* file = fopen(filepath.c_str(), "w");
+        if (!file) {
+            SDL_Log("Warning: Could not open trace file '%s'.", filepath.c_str());
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        bool first = true;
+        size_t total = 0;
+        for (const auto& buffer : m_buffers) {
+            // ߳Ԫݣ Perfetto ̷ֹ߳ʾ
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+                first ? "" : ",\n", buffer->threadIndex, "Thread", buffer->threadIndex);
+            first = false;
+
+            uint64_t count = buffer->count.load(std::memory_order_acquire);
+            uint64_t begin = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0;
+            for (uint64_t i = begin; i < count; ++i) {
+                const ProfileEvent& event = buffer->events[i & (EVENTS_PER_THREAD - 1)];
+                // Chrome trace ʱ䵥λ΢
+                fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"morpheus\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u",
+                    event.name, buffer->threadIndex, event.startNs / 1000.0, event.durationNs / 1000.0, event.frame);
+                if (event.arg >= 0) fprintf(file, ",\"arg\":%lld", (long long)event.arg);
+                fprintf(file, "}}");
+            }
+            total += static_cast<size_t>(count - begin);
+        }
+        fprintf(file, "\n]}\n");
+        bool ok = !ferror(file);
+        fclose(file);
+
+        SDL_Log("Wrote %zu profiler events to '%s'.", total, filepath.c_str());
+        return ok;
+    }
+}
@@ -0,0 +1,95 @@
+// src/core/Profiler.h (ļ)
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Morpheus::Core {
+
+    // һʱ¼
+    struct ProfileEvent {
+        const char* name;   // ַ (ָֻ)
+        int64_t startNs;    //  Profiler ʱ
+        int64_t durationNs;
+        int64_t arg;        // Ӳ (߿)-1 ʾû
+        uint32_t frame;
+    };
+
+    // ķ̼߳ʱ
+    // ÿ̵߳һμ¼¼ʱһԼĻλ壬д벻д󸲸ɵ¼
+    // WriteChromeTrace ̵߳¼д Chrome trace / Perfetto ܴ򿪵 JSON
+    // Ӧ֮֡ (ʱû߳д¼)
+    class Profiler {
+    public:
+        static Profiler& Get();
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+        bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+        // ֡Ż¼֮ÿ¼
+        void BeginFrame() { m_frame.fetch_add(1, std::memory_order_relaxed); }
+
+        int64_t Now() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+        }
+        void Record(const char* name, int64_t startNs, int64_t endNs, int64_t arg);
+
+        // д Chrome trace ʽ JSONʧʱ false
+        bool WriteChromeTrace(const std::string& filepath);
+
+    private:
+        Profiler();
+
+        // ÿ̵߳Ļλ壬 2 
+        static constexpr size_t EVENTS_PER_THREAD = 1 << 15;
+        struct ThreadBuffer {
+            uint32_t threadIndex = 0;
+            std::atomic<uint64_t> count{ 0 }; // д¼
+            std::vector<ProfileEvent> events;
+        };
+        ThreadBuffer& GetThreadBuffer();
+
+        std::atomic<bool> m_enabled{ false };
+        std::atomic<uint32_t> m_frame{ 0 };
+        std::chrono::steady_clock::time_point m_epoch;
+
+        std::mutex m_buffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    };
+
+    // ʱʱʼʱʱ¼һ¼Profiler δʱûп
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name, int64_t arg = -1)
+            : m_name(name), m_arg(arg) {
+            if (Profiler::Get().IsEnabled()) m_start = Profiler::Get().Now();
+        }
+        ~ProfileScope() {
+            if (m_start >= 0) {
+                Profiler& profiler = Profiler::Get();
+                profiler.Record(m_name, m_start, profiler.Now(), m_arg);
+            }
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_name;
+        int64_t m_arg;
+        int64_t m_start = -1;
+    };
+}
+
+#define MORPHEUS_PROFILE_CONCAT_INNER(a, b) a##b
+#define MORPHEUS_PROFILE_CONCAT(a, b) MORPHEUS_PROFILE_CONCAT_INNER(a, b)
+// ÷: MORPHEUS_PROFILE_SCOPE("Binning");  MORPHEUS_PROFILE_SCOPE_ARG("RasterTile", tile_index);
+#define MORPHEUS_PROFILE_SCOPE(name) ::Morpheus::Core::ProfileScope MORPHEUS_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define MORPHEUS_PROFILE_SCOPE_ARG(name, arg) ::Morpheus::Core::ProfileScope MORPHEUS_PROFILE_CONCAT(profile_scope_, __LINE__)(name, static_cast<int64_t>(arg))
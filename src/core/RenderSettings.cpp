@@ -0,0 +1,41 @@
+// src/core/RenderSettings.cpp (ļ)
+#include "RenderSettings.h"
+#include "../renderer/Renderer.h"
+#include "../scene/Scene.h"
+
+namespace Morpheus::Core {
+
+    bool ParseRenderFlag(const std::string& arg, RenderSettings& settings) {
+        if (arg == "--deferred") settings.deferredShading = true;
+        else if (arg == "--oit") settings.orderIndependentTransparency = true;
+        else if (arg == "--msaa") settings.multisampling = true;
+        else if (arg == "--taa") settings.temporalAA = true;
+        else if (arg == "--vrs-periphery") settings.peripheralShadingRate = true;
+        else return false;
+        return true;
+    }
+
+    void ApplyRenderSettings(const RenderSettings& settings, Renderer::Renderer& renderer) {
+        renderer.SetDeferredShading(settings.deferredShading);
+        renderer.SetOrderIndependentTransparency(settings.orderIndependentTransparency);
+        renderer.SetMultisampling(settings.multisampling);
+        renderer.SetTemporalAA(settings.temporalAA);
+        if (settings.peripheralShadingRate) renderer.SetShadingRateImage(renderer.MakePeripheralShadingRateImage());
+    }
+
+    FrameCamera::FrameCamera(const RenderSettings& settings, Scene::Scene& scene)
+        : m_scene(scene), m_aspect((float)settings.width / (float)settings.height) {
+        if (!settings.cameraPath.empty()) {
+            m_path = CameraPath::Load(settings.cameraPath);
+        }
+        else {
+            m_scene.GetCamera().SetPerspective(45.0f, m_aspect, 0.1f, 100.0f);
+        }
+        m_fps = settings.fps > 0.0f ? settings.fps : m_path.GetFps();
+    }
+
+    void FrameCamera::Apply(int frame) {
+        if (m_path.IsEmpty()) return;
+        m_path.Apply(m_scene.GetCamera(), (float)frame / m_fps, m_aspect);
+    }
+}
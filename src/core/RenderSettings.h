@@ -0,0 +1,45 @@
+// src/core/RenderSettings.h (ļ)
+#pragma once
+#include "CameraPath.h"
+#include <string>
+
+namespace Morpheus::Renderer { class Renderer; }
+namespace Morpheus::Scene { class Scene; }
+
+namespace Morpheus::Core {
+
+    // Ⱦ (--headless)  MorpheusBench õȾ
+    // µȾֻҪкȾûͬʱ֧
+    struct RenderSettings {
+        int width = 800;
+        int height = 600;
+        std::string cameraPath;                    // Ϊʱʹóļľ̬
+        float fps = 0.0f;                          // <= 0 ʱʹ· fps
+        bool deferredShading = false;              // ʹӳɫ ( Renderer::SetDeferredShading)
+        bool orderIndependentTransparency = false; // ͸ʹ˳޹͸ ( Renderer::SetOrderIndependentTransparency)
+        bool multisampling = false;                // 4x ز ( Renderer::SetMultisampling)
+        bool temporalAA = false;                   // ʱ俹 ( Renderer::SetTemporalAA)
+        bool peripheralShadingRate = false;        // ĻԵɫ ( Renderer::MakePeripheralShadingRateImage)
+    };
+
+    // ֵȾ (--deferred--oit )arg ֮һʱ true
+    bool ParseRenderFlag(const std::string& arg, RenderSettings& settings);
+
+    //  settings ĿӦõȾ (Ⱦ settings ķֱʴ)
+    void ApplyRenderSettings(const RenderSettings& settings, Renderer::Renderer& renderer);
+
+    // ֡·ʱ·ǰ ( frame ֡ʱ frame / fps)
+    // ʹóļľֻ̬һͶӰ
+    class FrameCamera {
+    public:
+        // ·ʧʱ׳ std::runtime_error
+        FrameCamera(const RenderSettings& settings, Scene::Scene& scene);
+        void Apply(int frame);
+
+    private:
+        Scene::Scene& m_scene;
+        CameraPath m_path;
+        float m_fps = 30.0f;
+        float m_aspect = 1.0f;
+    };
+}
@@ -0,0 +1,53 @@
+// src/core/ThreadPool.cpp (ļ)
+#include "ThreadPool.h"
+
+namespace Morpheus::Core {
+
+    ThreadPool::ThreadPool(unsigned int numThreads) {
+        if (numThreads == 0) numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0) numThreads = 4;
+
+        for (unsigned int i = 0; i < numThreads; ++i) {
+            m_workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+        for (auto& t : m_workers) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    ThreadPool& ThreadPool::Get() {
+        static ThreadPool instance; // Meyers' Singleton
+        return instance;
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.push_back(std::move(job));
+        }
+        m_condition.notify_one();
+    }
+
+    void ThreadPool::WorkerLoop() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+                // ˳ǰȰѶʣµ֤꣬Ѿȥ future õ
+                if (m_stopping && m_jobs.empty()) return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+}
@@ -0,0 +1,103 @@
+// src/core/ThreadPool.h (ļ)
+#pragma once
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <exception>
+#include <type_traits>
+
+namespace Morpheus::Core {
+
+    // һ򵥵Ĺ̶С̳߳
+    // Submit һ std::futureֻҪʱȥ get()
+    class ThreadPool {
+    public:
+        // numThreads Ϊ 0 ʱʹ hardware_concurrency
+        explicit ThreadPool(unsigned int numThreads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // ȫֹ̳߳أԴصȺ̨
+        static ThreadPool& Get();
+
+        // ύһ񣬷 future (׳쳣 get() ʱ׳)
+        template<typename Fn>
+        auto Submit(Fn&& fn) -> std::future<std::invoke_result_t<std::decay_t<Fn>>> {
+            using Result = std::invoke_result_t<std::decay_t<Fn>>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+            std::future<Result> result = task->get_future();
+            Enqueue([task]() { (*task)(); });
+            return result;
+        }
+
+        //  [0, count) ÿ fn(index) ִУȫɺŷ
+        // ߳ԼҲȡ̳߳ڲǶ׵ҲΪ̱߳ռ
+        // fn ׳ĵһ쳣ڵ߳׳
+        template<typename Fn>
+        void ParallelFor(size_t count, Fn&& fn) {
+            if (count == 0) return;
+            if (count == 1 || m_workers.empty()) {
+                for (size_t i = 0; i < count; ++i) fn(i);
+                return;
+            }
+
+            // ״̬ shared_ptr Уĸ߳̿ڵ÷֮ſʼУ
+            // ֻῴѾ겢ֱ˳ٷ fn
+            struct State {
+                std::atomic<size_t> next{ 0 };
+                std::atomic<size_t> completed{ 0 };
+                std::mutex mutex;
+                std::condition_variable done;
+                std::exception_ptr error;
+            };
+            auto state = std::make_shared<State>();
+            auto* body = &fn;
+            auto run = [state, body, count]() {
+                for (size_t i = state->next.fetch_add(1); i < count; i = state->next.fetch_add(1)) {
+                    try {
+                        (*body)(i);
+                    }
+                    catch (...) {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    if (state->completed.fetch_add(1) + 1 == count) {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        state->done.notify_all();
+                    }
+                }
+            };
+
+            size_t helpers = std::min(count - 1, m_workers.size());
+            for (size_t h = 0; h < helpers; ++h) {
+                Enqueue(run);
+            }
+            run();
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->done.wait(lock, [&]() { return state->completed.load() == count; });
+            if (state->error) std::rethrow_exception(state->error);
+        }
+
+        unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+    private:
+        void Enqueue(std::function<void()> job);
+        void WorkerLoop();
+
+        std::vector<std::thread> m_workers;
+        std::deque<std::function<void()>> m_jobs;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopping = false;
+    };
+}
@@ -1,9 +1,113 @@
 #include "core/Application.h"
+#include "core/HeadlessRunner.h"
+#include "renderer/Renderer.h"
 #include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <string>
+
+void PrintUsage() {
+    std::cerr <<
+        "Usage:\n"
+        "  MorpheusApp [--oit] [scene.json]\n"
+        "  MorpheusApp --headless [options]\n"
+        "Headless options:\n"
+        "  --scene <path>         scene file (default assets/scenes/test_scene.json)\n"
+        "  --size <W>x<H>         resolution (default 800x600)\n"
+        "  --camera-path <path>   camera keyframe JSON (default: static scene camera)\n"
+        "  --frames <N>           number of frames to render (default 1)\n"
+        "  --fps <F>              playback rate for the camera path (default: from the path file)\n"
+        "  --output <pattern>     .png/.ppm/.raw path, one %d or %0Nd for the frame number (%% = literal %),\n"
+        "                         or - for raw BGRA frames on stdout (default frame_%04d.png)\n"
+        "  --trace <path>         write a Chrome trace / Perfetto JSON of all frames\n"
+        "  --overdraw <pattern>   also write an overdraw heatmap per frame (same formats as --output)\n"
+        "  --stats                log triangle / fragment counters for every frame\n"
+        "  --deferred             use deferred shading for opaque objects that support it\n"
+        "  --oit                  order-independent transparency (weighted blended)\n"
+        "  --msaa                 4x multisample anti-aliasing (forward shading only)\n"
+        "  --taa                  temporal anti-aliasing (jittered projection + history reprojection)\n"
+        "  --vrs-periphery        coarser shading rate (2x2 / 4x4) towards the screen edges\n"
+        "Windowed mode: press F9 to write morpheus_trace.json.\n";
+}
+
+//  --headless ģʽĲʱ false
+bool ParseHeadlessOptions(int argc, char* argv[], Morpheus::Core::HeadlessOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless") continue;
+        if (arg == "--stats") {
+            options.printStats = true;
+            continue;
+        }
+        if (Morpheus::Core::ParseRenderFlag(arg, options.render)) continue;
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--scene") options.scenePath = value;
+        else if (arg == "--camera-path") options.render.cameraPath = value;
+        else if (arg == "--output") options.outputPattern = value;
+        else if (arg == "--trace") options.tracePath = value;
+        else if (arg == "--overdraw") options.overdrawPattern = value;
+        else if (arg == "--frames") options.frameCount = std::stoi(value);
+        else if (arg == "--fps") options.render.fps = std::stof(value);
+        else if (arg == "--size") {
+            if (sscanf(value.c_str(), "%dx%d", &options.render.width, &options.render.height) != 2) {
+                std::cerr << "Invalid size: " << value << std::endl;
+                return false;
+            }
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    if (options.render.width <= 0 || options.render.height <= 0 || options.frameCount <= 0) {
+        std::cerr << "Size and frame count must be positive." << std::endl;
+        return false;
+    }
+    return true;
+}
 
 int main(int argc, char* argv[]) {
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) headless = true;
+        if (std::strcmp(argv[i], "--help") == 0) {
+            PrintUsage();
+            return 0;
+        }
+    }
+
     try {
-        Morpheus::Core::Application app("Morpheus Renderer", 800, 600);
+        if (headless) {
+            // ȾڣҲʼ SDL Ƶϵͳ
+            Morpheus::Core::HeadlessOptions options;
+            if (!ParseHeadlessOptions(argc, argv, options)) {
+                PrintUsage();
+                return 1;
+            }
+            Morpheus::Core::HeadlessRunner runner(options);
+            return runner.Run();
+        }
+
+        // ģʽһѡĲǳļֻ֧ --oit
+        std::string scene_path = "assets/scenes/test_scene.json";
+        bool order_independent_transparency = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--oit") order_independent_transparency = true;
+            else if (arg.rfind("--", 0) == 0) {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                PrintUsage();
+                return 1;
+            }
+            else scene_path = arg;
+        }
+
+        Morpheus::Core::Application app("Morpheus Renderer", 800, 600, scene_path);
+        app.GetRenderer().SetOrderIndependentTransparency(order_independent_transparency);
         app.Run();
     }
     catch (const std::exception& e) {
@@ -11,4 +115,4 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -209,6 +209,36 @@ namespace Morpheus::Math {
             return mat;
         }
 
+        // ͶӰ (OpenGL Լ -Zӳ䵽 [-1, 1])
+        static Matrix4f Orthographic(float left, float right, float bottom, float top, float zNear, float zFar) {
+            assert(right > left && top > bottom && zFar > zNear);
+
+            Matrix4f mat = Identity();
+            mat.m[0][0] = 2.0f / (right - left);
+            mat.m[1][1] = 2.0f / (top - bottom);
+            mat.m[2][2] = -2.0f / (zFar - zNear);
+            mat.m[0][3] = -(right + left) / (right - left);
+            mat.m[1][3] = -(top + bottom) / (top - bottom);
+            mat.m[2][3] = -(zFar + zNear) / (zFar - zNear);
+            return mat;
+        }
+
+        // ۲ Camera::UpdateViewMatrix ͬϵԼ (up ƽ)
+        static Matrix4f LookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up) {
+            Vector3f zaxis = normalize(eye - target);
+            Vector3f xaxis = normalize(cross(up, zaxis));
+            Vector3f yaxis = cross(zaxis, xaxis);
+
+            Matrix4f mat = Identity();
+            mat.m[0][0] = xaxis.x(); mat.m[0][1] = xaxis.y(); mat.m[0][2] = xaxis.z();
+            mat.m[1][0] = yaxis.x(); mat.m[1][1] = yaxis.y(); mat.m[1][2] = yaxis.z();
+            mat.m[2][0] = zaxis.x(); mat.m[2][1] = zaxis.y(); mat.m[2][2] = zaxis.z();
+            mat.m[0][3] = -dot(xaxis, eye);
+            mat.m[1][3] = -dot(yaxis, eye);
+            mat.m[2][3] = -dot(zaxis, eye);
+            return mat;
+        }
+
         static Matrix4f Translate(const Vector3f& v) {
             Matrix4f result = Identity();
             result[0][3] = v.x();
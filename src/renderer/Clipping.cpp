@@ -1,6 +1,5 @@
 // src/renderer/Clipping.cpp (ļ)
 #include "Clipping.h"
-#include <functional>
 
 namespace Morpheus::Renderer {
 
@@ -21,41 +20,52 @@ namespace Morpheus::Renderer {
         return result;
     }
 
-    // ĺһƽüһ
-    // ʹ std::function ̬ÿƽԺཻ
-    std::vector<Varyings> ClipPolygonAgainstPlane(const std::vector<Varyings>& vertices,
-        std::function<bool(const Varyings&)> is_inside,
-        std::function<Varyings(const Varyings&, const Varyings&)> intersect) {
-        std::vector<Varyings> out_vertices;
-        if (vertices.empty()) {
-            return out_vertices;
+    // ĺһƽüһ (Sutherland-Hodgman)д out
+    // Ժཻģ룬԰ѭ
+    template<typename InsideFn, typename IntersectFn>
+    void ClipPolygonAgainstPlane(const ClippedPolygon& in, ClippedPolygon& out, InsideFn is_inside, IntersectFn intersect) {
+        out.count = 0;
+        if (in.count == 0) {
+            return;
         }
 
-        for (size_t i = 0; i < vertices.size(); ++i) {
-            const Varyings& current_v = vertices[i];
-            const Varyings& prev_v = vertices[(i + vertices.size() - 1) % vertices.size()];
+        for (int i = 0; i < in.count; ++i) {
+            const Varyings& current_v = in.vertices[i];
+            const Varyings& prev_v = in.vertices[(i + in.count - 1) % in.count];
 
             bool is_current_inside = is_inside(current_v);
             bool is_prev_inside = is_inside(prev_v);
 
             if (is_current_inside != is_prev_inside) {
                 // ƽཻ
-                out_vertices.push_back(intersect(prev_v, current_v));
+                out.vertices[out.count++] = intersect(prev_v, current_v);
             }
             if (is_current_inside) {
                 // ǰڲ
-                out_vertices.push_back(current_v);
+                out.vertices[out.count++] = current_v;
             }
         }
-        return out_vertices;
+    }
+
+    bool IsInsideClipVolume(const Varyings& v) {
+        const Math::Vector4f& p = v.position_clip;
+        return p.w() > 0.0001f &&
+            p.x() <= p.w() && p.x() >= -p.w() &&
+            p.y() <= p.w() && p.y() >= -p.w() &&
+            p.z() <= p.w() && p.z() >= -p.w();
     }
 
     // ܲü
-    std::vector<Varyings> ClipTriangle(const Varyings& v0, const Varyings& v1, const Varyings& v2) {
-        std::vector<Varyings> vertices = { v0, v1, v2 };
+    void ClipTriangle(const Varyings& v0, const Varyings& v1, const Varyings& v2, ClippedPolygon& out) {
+        //  out һʱ֮زü7 ƽ֮ out 
+        ClippedPolygon scratch;
+        scratch.vertices[0] = v0;
+        scratch.vertices[1] = v1;
+        scratch.vertices[2] = v2;
+        scratch.count = 3;
 
         // 1. Vs W plane (Near plane in some conventions, or just w>epsilon)
-        vertices = ClipPolygonAgainstPlane(vertices,
+        ClipPolygonAgainstPlane(scratch, out,
             [](const Varyings& v) { return v.position_clip.w() > 0.0001f; }, // Inside if w > epsilon
             [](const Varyings& prev, const Varyings& current) {
                 float t = (prev.position_clip.w() - 0.0001f) / (prev.position_clip.w() - current.position_clip.w());
@@ -63,52 +73,44 @@ namespace Morpheus::Renderer {
             });
 
         // 2. Vs X planes
-        vertices = ClipPolygonAgainstPlane(vertices, [](const Varyings& v) { return v.position_clip.x() <= v.position_clip.w(); }, // Left
+        ClipPolygonAgainstPlane(out, scratch, [](const Varyings& v) { return v.position_clip.x() <= v.position_clip.w(); }, // Left
             [](const Varyings& prev, const Varyings& current) {
                 float t = (prev.position_clip.w() - prev.position_clip.x()) / ((prev.position_clip.w() - prev.position_clip.x()) - (current.position_clip.w() - current.position_clip.x()));
                 return InterpolateVaryings(prev, current, t);
             });
-        vertices = ClipPolygonAgainstPlane(vertices, [](const Varyings& v) { return v.position_clip.x() >= -v.position_clip.w(); }, // Right
+        ClipPolygonAgainstPlane(scratch, out, [](const Varyings& v) { return v.position_clip.x() >= -v.position_clip.w(); }, // Right
             [](const Varyings& prev, const Varyings& current) {
                 float t = (prev.position_clip.w() + prev.position_clip.x()) / ((prev.position_clip.w() + prev.position_clip.x()) - (current.position_clip.w() + current.position_clip.x()));
                 return InterpolateVaryings(prev, current, t);
             });
 
         // 3. Vs Y planes
-        vertices = ClipPolygonAgainstPlane(vertices, [](const Varyings& v) { return v.position_clip.y() <= v.position_clip.w(); }, // Top
+        ClipPolygonAgainstPlane(out, scratch, [](const Varyings& v) { return v.position_clip.y() <= v.position_clip.w(); }, // Top
             [](const Varyings& prev, const Varyings& current) {
                 float t = (prev.position_clip.w() - prev.position_clip.y()) / ((prev.position_clip.w() - prev.position_clip.y()) - (current.position_clip.w() - current.position_clip.y()));
                 return InterpolateVaryings(prev, current, t);
             });
-        vertices = ClipPolygonAgainstPlane(vertices, [](const Varyings& v) { return v.position_clip.y() >= -v.position_clip.w(); }, // Bottom
+        ClipPolygonAgainstPlane(scratch, out, [](const Varyings& v) { return v.position_clip.y() >= -v.position_clip.w(); }, // Bottom
             [](const Varyings& prev, const Varyings& current) {
                 float t = (prev.position_clip.w() + prev.position_clip.y()) / ((prev.position_clip.w() + prev.position_clip.y()) - (current.position_clip.w() + current.position_clip.y()));
                 return InterpolateVaryings(prev, current, t);
             });
 
         // 4. Vs Z planes
-        vertices = ClipPolygonAgainstPlane(vertices, [](const Varyings& v) { return v.position_clip.z() <= v.position_clip.w(); }, // Far
+        ClipPolygonAgainstPlane(out, scratch, [](const Varyings& v) { return v.position_clip.z() <= v.position_clip.w(); }, // Far
             [](const Varyings& prev, const Varyings& current) {
                 float t = (prev.position_clip.w() - prev.position_clip.z()) / ((prev.position_clip.w() - prev.position_clip.z()) - (current.position_clip.w() - current.position_clip.z()));
                 return InterpolateVaryings(prev, current, t);
             });
-        vertices = ClipPolygonAgainstPlane(vertices, [](const Varyings& v) { return v.position_clip.z() >= -v.position_clip.w(); }, // Near
+        ClipPolygonAgainstPlane(scratch, out, [](const Varyings& v) { return v.position_clip.z() >= -v.position_clip.w(); }, // Near
             [](const Varyings& prev, const Varyings& current) {
                 float t = (prev.position_clip.w() + prev.position_clip.z()) / ((prev.position_clip.w() + prev.position_clip.z()) - (current.position_clip.w() + current.position_clip.z()));
                 return InterpolateVaryings(prev, current, t);
             });
 
-
-        // 5. Triangulate the final polygon (Fan Triangulation)
-        std::vector<Varyings> triangles;
-        if (vertices.size() >= 3) {
-            for (size_t i = 1; i < vertices.size() - 1; ++i) {
-                triangles.push_back(vertices[0]);
-                triangles.push_back(vertices[i]);
-                triangles.push_back(vertices[i + 1]);
-            }
+        // 5. ȫ׶ʱ 3߰β
+        if (out.count < 3) {
+            out.count = 0;
         }
-
-        return triangles;
     }
 }
@@ -1,16 +1,29 @@
 // src/renderer/Clipping.h (ļ)
 #pragma once
 #include "IShader.h" // For Varyings
-#include <vector>
 
 namespace Morpheus::Renderer {
 
-    // üһεVaryingһüΡ
-    // vectorС3ıÿ3VaryingһΡ
-    std::vector<Varyings> ClipTriangle(
+    // Ƿڲüռ׶ ( ClipTriangle ʹõĲüƽһ)
+    // 㶼׶ڵβҪü
+    bool IsInsideClipVolume(const Varyings& v);
+
+    // α 7 ƽü (w > epsilon + 6 ׶)ÿƽ͹ζһ
+    constexpr int MAX_CLIPPED_VERTICES = 3 + 7;
+
+    // ü͹ΣֱӴڽṹ (ջϣüٷڴ)
+    struct ClippedPolygon {
+        Varyings vertices[MAX_CLIPPED_VERTICES];
+        int count = 0;
+    };
+
+    // üһεVaryingü͹Ρ
+    //  3 ʾȫ׶⣻ (0, i, i + 1)  count - 2 Ρ
+    void ClipTriangle(
         const Varyings& v0,
         const Varyings& v1,
-        const Varyings& v2
+        const Varyings& v2,
+        ClippedPolygon& out
     );
 
 }
@@ -1,34 +1,11 @@
 #include "Framebuffer.h"
 #include <algorithm>
+#include <iterator>
+#include <cassert>
+#include "../math/Common.h"
 
 namespace Morpheus::Renderer {
 
-    // --- һڽ uint32_t  Vector4f ---
-    // ע⣺̲ Gamma 룬ΪǻʱҪɫ
-    Math::Vector4f from_color_linear(uint32_t c) {
-        float r_gamma = ((c >> 16) & 0xFF) / 255.0f;
-        float g_gamma = ((c >> 8) & 0xFF) / 255.0f;
-        float b_gamma = (c & 0xFF) / 255.0f;
-        float a = ((c >> 24) & 0xFF) / 255.0f;
-
-        // ֮ǰ Gamma 2.2 
-        return {
-            std::pow(r_gamma, 2.2f),
-            std::pow(g_gamma, 2.2f),
-            std::pow(b_gamma, 2.2f),
-            a
-        };
-    }
-
-    // Helper to convert float color [0,1] to uint32_t 0xAARRGGBB
-    uint32_t to_color(const Math::Vector4f& c) {
-        uint8_t r = static_cast<uint8_t>(std::clamp(c.x(), 0.0f, 1.0f) * 255.0f);
-        uint8_t g = static_cast<uint8_t>(std::clamp(c.y(), 0.0f, 1.0f) * 255.0f);
-        uint8_t b = static_cast<uint8_t>(std::clamp(c.z(), 0.0f, 1.0f) * 255.0f);
-        uint8_t a = static_cast<uint8_t>(std::clamp(c.w(), 0.0f, 1.0f) * 255.0f);
-        return (a << 24) | (r << 16) | (g << 8) | b;
-    }
-
     Framebuffer::Framebuffer(int width, int height)
         : m_width(width), m_height(height) {
         m_colorBuffer.resize(width * height);
@@ -87,6 +64,10 @@ namespace Morpheus::Renderer {
         }
         // Ȳԣֱͨ
 
+        if (!m_overdrawBuffer.empty() && m_overdrawBuffer[index] < UINT16_MAX) {
+            m_overdrawBuffer[index]++;
+        }
+
         // --- ɫд Alpha  ---
         bool blending_enabled = state.IsFlagEnabled(RenderStateFlags::BlendEnable);
         if (blending_enabled) {
@@ -124,10 +105,49 @@ namespace Morpheus::Renderer {
         }
     }
 
+    void Framebuffer::CopyDepthFrom(const Framebuffer& other) {
+        assert(other.m_width == m_width && other.m_height == m_height);
+        std::copy(other.m_depthBuffer.begin(), other.m_depthBuffer.end(), m_depthBuffer.begin());
+    }
+
     // --- ClearDepth ʵ ---
     void Framebuffer::ClearDepth(float depth) {
         std::fill(m_depthBuffer.begin(), m_depthBuffer.end(), depth);
     }
 
+    // --- Overdraw ͳ ---
+    void Framebuffer::SetOverdrawEnabled(bool enabled) {
+        if (enabled) {
+            m_overdrawBuffer.assign(m_width * m_height, 0);
+        }
+        else {
+            m_overdrawBuffer.clear();
+            m_overdrawBuffer.shrink_to_fit();
+        }
+    }
+
+    void Framebuffer::ClearOverdraw() {
+        std::fill(m_overdrawBuffer.begin(), m_overdrawBuffer.end(), uint16_t(0));
+    }
 
+    std::vector<uint32_t> Framebuffer::GetOverdrawHeatmap(int maxOverdraw) const {
+        // ͼɫڵ㣬 0 ΪɫmaxOverdraw Ϊɫ
+        static const Math::Vector4f ramp[] = {
+            { 0.0f, 0.0f, 0.0f, 1.0f },
+            { 0.0f, 0.0f, 1.0f, 1.0f },
+            { 0.0f, 1.0f, 0.0f, 1.0f },
+            { 1.0f, 1.0f, 0.0f, 1.0f },
+            { 1.0f, 0.0f, 0.0f, 1.0f },
+            { 1.0f, 1.0f, 1.0f, 1.0f },
+        };
+        const int last = static_cast<int>(std::size(ramp)) - 1;
+
+        std::vector<uint32_t> heatmap(m_overdrawBuffer.size());
+        for (size_t i = 0; i < m_overdrawBuffer.size(); ++i) {
+            float t = std::min(1.0f, (float)m_overdrawBuffer[i] / (float)std::max(1, maxOverdraw)) * last;
+            int k = std::min(last - 1, (int)t);
+            heatmap[i] = to_color(Math::Lerp(ramp[k], ramp[k + 1], t - k));
+        }
+        return heatmap;
+    }
 }
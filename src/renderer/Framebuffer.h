@@ -1,10 +1,52 @@
 #pragma once
 #include <vector>
 #include <cstdint>
+#include <cmath>
+#include <algorithm>
 #include "../math/Vector.h" // ע·
 #include "RenderState.h"
 
 namespace Morpheus::Renderer {
+
+    // --- һڽ uint32_t  Vector4f ---
+    // ע⣺̲ Gamma 룬ΪǻʱҪɫ
+    inline Math::Vector4f from_color_linear(uint32_t c) {
+        float r_gamma = ((c >> 16) & 0xFF) / 255.0f;
+        float g_gamma = ((c >> 8) & 0xFF) / 255.0f;
+        float b_gamma = (c & 0xFF) / 255.0f;
+        float a = ((c >> 24) & 0xFF) / 255.0f;
+
+        // ֮ǰ Gamma 2.2 
+        return {
+            std::pow(r_gamma, 2.2f),
+            std::pow(g_gamma, 2.2f),
+            std::pow(b_gamma, 2.2f),
+            a
+        };
+    }
+
+    // Helper to convert float color [0,1] to uint32_t 0xAARRGGBB
+    inline uint32_t to_color(const Math::Vector4f& c) {
+        uint8_t r = static_cast<uint8_t>(std::clamp(c.x(), 0.0f, 1.0f) * 255.0f);
+        uint8_t g = static_cast<uint8_t>(std::clamp(c.y(), 0.0f, 1.0f) * 255.0f);
+        uint8_t b = static_cast<uint8_t>(std::clamp(c.z(), 0.0f, 1.0f) * 255.0f);
+        uint8_t a = static_cast<uint8_t>(std::clamp(c.w(), 0.0f, 1.0f) * 255.0f);
+        return (a << 24) | (r << 16) | (g << 8) | b;
+    }
+
+    // ԴɫԼ alpha ɫ dst  (src * a + dst * (1 - a))дصɫ
+    inline uint32_t blend_color(const Math::Vector4f& src, uint32_t dst) {
+        Math::Vector4f dst_color = from_color_linear(dst);
+        float src_alpha = src.w();
+
+        Math::Vector4f final_color;
+        final_color.x() = src.x() * src_alpha + dst_color.x() * (1.0f - src_alpha);
+        final_color.y() = src.y() * src_alpha + dst_color.y() * (1.0f - src_alpha);
+        final_color.z() = src.z() * src_alpha + dst_color.z() * (1.0f - src_alpha);
+        final_color.w() = src_alpha + dst_color.w() * (1.0f - src_alpha);
+        return to_color(final_color);
+    }
+
     class Framebuffer {
     public:
         Framebuffer(int width, int height);
@@ -19,6 +61,53 @@ namespace Morpheus::Renderer {
         // --- ޸ SetPixelȲ߼ ---
         void SetPixel(int x, int y, float z, const Math::Vector4f& color, const RenderState& state);
 		void SetDepth(int x, int y, float depth); //SetDepthshadow pass
+        // һͬС Framebuffer Ȼ (Ӱ)
+        void CopyDepthFrom(const Framebuffer& other);
+        // ֻȲԲд룬ƬԪɫ֮ǰ޳ڵƬԪ (state δȲʱͨ)
+        bool DepthTest(int x, int y, float depth, const RenderState& state) const {
+            if (!state.IsFlagEnabled(RenderStateFlags::DepthTestEnable)) return true;
+            return depth < m_depthBuffer[(m_height - 1 - y) * m_width + x];
+        }
+
+        // --- ȷȾ״̬İ汾 (ģդʹ) ---
+        // Flags  RenderStateFlags ϣδĲԺдڱھͱȥѭûз֧
+        template<uint32_t Flags>
+        bool DepthTest(int x, int y, float depth) const {
+            if constexpr ((Flags & static_cast<uint32_t>(RenderStateFlags::DepthTestEnable)) == 0) return true;
+            return depth < m_depthBuffer[(m_height - 1 - y) * m_width + x];
+        }
+        // ֤߱ڷΧڣѾ DepthTest<Flags> Թ (ͬһֻһ߳дԽʧЧ)
+        // Flags  DepthOnly ʱֻдȣcolor  (ֻȻӰͼ·)
+        template<uint32_t Flags>
+        void WritePixel(int x, int y, float depth, const Math::Vector4f& color);
+        // ֱдɫԺͻ (鷶Χ)ӳɫĹ Pass
+        void SetColor(int x, int y, const Math::Vector4f& color) { m_colorBuffer[(m_height - 1 - y) * m_width + x] = to_color(color); }
+        // ȡɫ (鷶Χ)ʱһɫ
+        Math::Vector4f GetColor(int x, int y) const { return from_color_linear(m_colorBuffer[(m_height - 1 - y) * m_width + x]); }
+        // ȡ (鷶Χ)Լ SetPixel ͬ
+        float GetDepth(int x, int y) const { return m_depthBuffer[(m_height - 1 - y) * m_width + x]; }
+        //  y еʼλ (Լ SetPixel ͬڰ x )д (زϳ)
+        uint32_t* GetColorRow(int y) { return m_colorBuffer.data() + (size_t)(m_height - 1 - y) * m_width; }
+        float* GetDepthRow(int y) { return m_depthBuffer.data() + (size_t)(m_height - 1 - y) * m_width; }
+        const uint32_t* GetColorRow(int y) const { return m_colorBuffer.data() + (size_t)(m_height - 1 - y) * m_width; }
+        const float* GetDepthRow(int y) const { return m_depthBuffer.data() + (size_t)(m_height - 1 - y) * m_width; }
+        // ɫ/㣬 (x, y) ± (height - 1 - y) * width + x (դе±ʱʹ)
+        uint32_t* GetColorData() { return m_colorBuffer.data(); }
+        float* GetDepthData() { return m_depthBuffer.data(); }
+
+        // --- Overdraw ͳ (ѡ) ---
+        //  SetPixel ÿдһƬԪ͸Ӧؼһ
+        void SetOverdrawEnabled(bool enabled);
+        bool IsOverdrawEnabled() const { return !m_overdrawBuffer.empty(); }
+        void ClearOverdraw();
+        // ؼһ (ɫ SetPixel/WritePixel дʱʹãز)
+        void CountOverdraw(int x, int y) {
+            if (m_overdrawBuffer.empty()) return;
+            uint16_t& count = m_overdrawBuffer[(m_height - 1 - y) * m_width + x];
+            if (count < UINT16_MAX) count++;
+        }
+        // Ѽӳͼ ( ->  ->  ->  -> )ﵽ maxOverdraw ʾΪɫظʽɫͬ
+        std::vector<uint32_t> GetOverdrawHeatmap(int maxOverdraw = 8) const;
         
         int GetWidth() const { return m_width; }
         int GetHeight() const { return m_height; }
@@ -32,9 +121,46 @@ namespace Morpheus::Renderer {
         int m_height;
         std::vector<uint32_t> m_colorBuffer;
         std::vector<float> m_depthBuffer; 
+        std::vector<uint16_t> m_overdrawBuffer; // Ϊձʾδ Overdraw ͳ
 
         // --- Shadow Map Framebuffer  ---
        //  Shadow Map 
         std::shared_ptr<Texture> m_depthTexture;
     };
+
+    // дһѾͨȲԵƬԪɫ Flags ֱдϣȰ Flags д (ͳ Overdraw)
+    // color/depth ɫ飬index ص±ꣻFlags  DepthOnly ʱ color ᱻ
+    template<uint32_t Flags>
+    inline void write_fragment(uint32_t* color, float* depth, size_t index, float z, const Math::Vector4f& src) {
+        constexpr bool blend = (Flags & static_cast<uint32_t>(RenderStateFlags::BlendEnable)) != 0;
+        constexpr bool depth_write = (Flags & static_cast<uint32_t>(RenderStateFlags::DepthWriteEnable)) != 0;
+        constexpr bool depth_only = (Flags & static_cast<uint32_t>(RenderStateFlags::DepthOnly)) != 0;
+
+        if constexpr (!depth_only) {
+            if constexpr (blend) {
+                //  SetPixel ͬ Alpha 
+                color[index] = blend_color(src, color[index]);
+            }
+            else {
+                color[index] = to_color(src);
+            }
+        }
+        if constexpr (depth_write) {
+            depth[index] = z;
+        }
+    }
+
+    template<uint32_t Flags>
+    inline void Framebuffer::WritePixel(int x, int y, float depth, const Math::Vector4f& color) {
+        constexpr bool depth_only = (Flags & static_cast<uint32_t>(RenderStateFlags::DepthOnly)) != 0;
+
+        int index = (m_height - 1 - y) * m_width + x; // Yᷭת
+
+        if constexpr (!depth_only) {
+            if (!m_overdrawBuffer.empty() && m_overdrawBuffer[index] < UINT16_MAX) {
+                m_overdrawBuffer[index]++;
+            }
+        }
+        write_fragment<Flags>(m_colorBuffer.data(), m_depthBuffer.data(), index, depth, color);
+    }
 }
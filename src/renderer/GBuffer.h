@@ -0,0 +1,83 @@
+// src/renderer/GBuffer.h (ļ)
+#pragma once
+#include "IShader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Morpheus::Renderer {
+
+    // --- ӳɫ G-buffer ---
+    // ÿ 12 ֽ (֡)Էֿ (SoA) Pass ȡ
+    //   normal    ӳѹ 16 λзŶ
+    //   albedo    ɫÿͨ 8 λ (0x00RRGGBB)
+    //   shininess ߹ָ
+    // Լ Framebuffer ͬ (y )± y * width + x
+    // ǷдȾǰ֮ǰУʱСֵض G-buffer 
+    class GBuffer {
+    public:
+        void Resize(int width, int height) {
+            m_width = width;
+            m_height = height;
+            const size_t count = (size_t)width * height;
+            m_normal.assign(count, 0u);
+            m_albedo.assign(count, 0u);
+            m_shininess.assign(count, 0.0f);
+        }
+
+        // ֤߱ڷΧ (դʱÿֻɸ߿߳д)
+        void Write(int x, int y, const GBufferSample& sample) {
+            const size_t index = (size_t)y * m_width + x;
+            m_normal[index] = EncodeNormal(sample.normal);
+            m_albedo[index] = EncodeAlbedo(sample.albedo);
+            m_shininess[index] = sample.shininess;
+        }
+
+        int GetWidth() const { return m_width; }
+        int GetHeight() const { return m_height; }
+        //  y еʼλ
+        const uint32_t* NormalRow(int y) const { return m_normal.data() + (size_t)y * m_width; }
+        const uint32_t* AlbedoRow(int y) const { return m_albedo.data() + (size_t)y * m_width; }
+        const float* ShininessRow(int y) const { return m_shininess.data() + (size_t)y * m_width; }
+
+        // ӳ䣺λͶӰ |x| + |y| + |z| = 1 İϣ°۵
+        static uint32_t EncodeNormal(const Math::Vector3f& n) {
+            float inv_l1 = 1.0f / (std::abs(n.x()) + std::abs(n.y()) + std::abs(n.z()));
+            float u = n.x() * inv_l1;
+            float v = n.y() * inv_l1;
+            if (n.z() < 0.0f) {
+                float fu = (1.0f - std::abs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+                float fv = (1.0f - std::abs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+                u = fu;
+                v = fv;
+            }
+            auto to_snorm16 = [](float value) { return (uint32_t)(uint16_t)(int16_t)std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f); };
+            return to_snorm16(u) | (to_snorm16(v) << 16);
+        }
+        static Math::Vector3f DecodeNormal(uint32_t packed) {
+            float u = (float)(int16_t)(packed & 0xFFFF) * (1.0f / 32767.0f);
+            float v = (float)(int16_t)(packed >> 16) * (1.0f / 32767.0f);
+            float z = 1.0f - std::abs(u) - std::abs(v);
+            if (z < 0.0f) {
+                float fu = (1.0f - std::abs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+                float fv = (1.0f - std::abs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+                u = fu;
+                v = fv;
+            }
+            return Math::normalize(Math::Vector3f{ u, v, z });
+        }
+
+        static uint32_t EncodeAlbedo(const Math::Vector3f& c) {
+            auto to_unorm8 = [](float value) { return (uint32_t)std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f); };
+            return (to_unorm8(c.x()) << 16) | (to_unorm8(c.y()) << 8) | to_unorm8(c.z());
+        }
+
+    private:
+        int m_width = 0;
+        int m_height = 0;
+        std::vector<uint32_t> m_normal;
+        std::vector<uint32_t> m_albedo;
+        std::vector<float> m_shininess;
+    };
+}
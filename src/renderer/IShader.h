@@ -8,8 +8,8 @@
 #include <any> // C++17, ڴ洢͵uniforms
 
 // ǰ
-namespace Morpheus::Renderer { struct Vertex; struct Material; class Texture; class RenderState; }
-namespace Morpheus::Scene { class Light; }
+namespace Morpheus::Renderer { struct Vertex; struct Material; class Texture; class RenderState; struct ShadowMap; struct LocalLight; struct TileLightList; }
+namespace Morpheus::Scene { class Light; struct DirectionalLight; }
 
 
 namespace Morpheus::Renderer {
@@ -32,6 +32,64 @@ namespace Morpheus::Renderer {
         // Ҫǽ任߿ռľ
         Math::Vector3f tangent_space_light_dir;
         Math::Vector3f tangent_space_view_dir;
+
+        // ռߣѷͼ任ռ
+        Math::Vector3f world_tangent;
+
+        // ƬԪ߿ľֲԴбɹդд (ֵ)֡ϻʱΪ
+        const TileLightList* tile_lights = nullptr;
+    };
+
+    // --- Varyings  ---
+    // ɫλƬԪɫȡЩֵԣդֻ洢ͲֵЩ
+    // (position_clip Ǵڣֵ)
+    struct VaryingLayout {
+        static constexpr uint32_t Color = 1u << 0;
+        static constexpr uint32_t WorldPos = 1u << 1;
+        static constexpr uint32_t WorldNormal = 1u << 2;
+        static constexpr uint32_t UV = 1u << 3;
+        static constexpr uint32_t TangentSpaceLightDir = 1u << 4;
+        static constexpr uint32_t TangentSpaceViewDir = 1u << 5;
+        static constexpr uint32_t WorldTangent = 1u << 6;
+
+        static constexpr uint32_t None = 0;
+        static constexpr uint32_t All = (1u << 7) - 1;
+        static constexpr uint32_t Count = All + 1; // пܵĲ
+    };
+
+    // --- ÿλƵ Uniforms ---
+    // Ⱦÿ֡֡ڷ (FrameArena) Ϊÿһݣͨ RenderState::uniforms  VS  FS
+    // ֻƽ (ƹָ룬ǵ֡ڶ)
+    // ɫֱӶȡֶΣҪַ std::anyҲÿƬԪϿ vector/shared_ptr
+    struct DrawUniforms {
+        Math::Matrix4f model;
+        Math::Matrix4f view;
+        Math::Matrix4f projection;
+        Math::Matrix4f mvp;
+        Math::Matrix4f normal_matrix; // model ת
+
+        // ʲ
+        Math::Vector4f albedo_factor;
+        const Texture* albedo_texture = nullptr;
+        const Texture* normal_texture = nullptr;
+        float shininess = 32.0f;
+        float alpha_factor = 1.0f;
+
+        // Ϣ
+        Math::Vector3f camera_pos;
+        const Scene::DirectionalLight* lights = nullptr;
+        size_t light_count = 0;
+        //  lights һһӦӰͼرӰ (Ӱ Pass Լ) ʱΪ
+        const ShadowMap* shadow_maps = nullptr;
+        // ֡еĵԴ;۹ƣƬԪֻҪ Varyings::tile_lights гЩ
+        const LocalLight* local_lights = nullptr;
+    };
+
+    // --- G-buffer һصı (ӳɫ) ---
+    struct GBufferSample {
+        Math::Vector3f normal;  // ռ䣬λ
+        Math::Vector3f albedo;  // ɫ [0, 1]
+        float shininess = 32.0f;
     };
 
     // --- Shader ӿ ---
@@ -40,15 +98,27 @@ namespace Morpheus::Renderer {
         virtual ~IShader() = default;
 
         // --- ɫ ---
-        // : 
+        // : ԣԼλƵȾ״̬ (renderState.uniforms ָ Uniforms)
         // : ֵVaryingsṹ
-        virtual Varyings VertexShader(const Vertex& in) = 0;
+        virtual Varyings VertexShader(const Vertex& in, const RenderState& renderState) = 0;
 
         // --- ƬԪɫ ---
         // : ͸УֵVaryings
         // : յɫ (RGBA)
         virtual Math::Vector4f FragmentShader(const Varyings& in, const RenderState& renderState) = 0;
 
+        // ƬԪɫȡĲֵ (VaryingLayout )û FS δֵ
+        // ĬϲֵȫԣɫֻԼõ
+        virtual uint32_t GetVaryingMask() const { return VaryingLayout::All; }
+
+        // --- ӳɫ ---
+        // ֵ֧ɫӳģʽ²ƬԪգֻѱд G-buffer֮ÿɼֻһΡ
+        // ֵ֧ɫ (Ĭ) ӳģʽճǰȾ
+        virtual bool SupportsGBuffer() const { return false; }
+        virtual GBufferSample GBufferFragment([[maybe_unused]] const Varyings& in, [[maybe_unused]] const RenderState& renderState) { return {}; }
+        // GBufferFragment ȡĲֵ
+        virtual uint32_t GetGBufferVaryingMask() const { return VaryingLayout::All; }
+
         //  Uniforms
         void SetUniform(const std::string& name, const std::any& value) {
             uniforms[name] = value;
@@ -75,8 +145,8 @@ namespace Morpheus::Renderer {
         }
 
         // --- Uniforms ---
-        // ڴȫֱλáƹ
-        // ʹ std::any ṩ˼
+        // ԶɫĶ (󡢲ʡƹò DrawUniforms )
+        // ʹ std::any ṩ˼ԣҺͿпҪÿƬԪȡ
         std::map<std::string, std::any> uniforms;
     };
 };
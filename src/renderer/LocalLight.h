@@ -0,0 +1,41 @@
+// src/renderer/LocalLight.h (ļ)
+#pragma once
+#include "../math/Vector.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace Morpheus::Renderer {
+
+    // --- ֲԴ (Դ;۹) ---
+    // Ⱦÿ֡ѳֹԴתͬһָʽŽ֡ڷԴ׶˥Ϊ 1
+    // ɫѭﲻҪͷ֧
+    struct LocalLight {
+        Math::Vector3f position;
+        float invRange;           // 1 / range
+        Math::Vector3f radiance;  // color * intensity
+        float spotScale;          // ׶˥ = saturate(cos(ļн) * spotScale + spotOffset)^2
+        Math::Vector3f direction; // ۹ƵĹ (ԴΪ 0)
+        float spotOffset;
+    };
+
+    // һ߿ĹԴб߿׶ (ȷΧ) ཻľֲԴ LocalLight ±
+    struct TileLightList {
+        const uint16_t* indices = nullptr;
+        uint32_t count = 0;
+    };
+
+    // ˥ƽ (ĸ 1Դ)ٳһ range ƽ 0 Ĵ (1 - (d / range)^4)^2
+    // range ֮ĹϸΪ 0԰Χ޳Դ߿߽ͻ
+    inline float DistanceAttenuation(float distance_sq, float inv_range) {
+        float ratio_sq = distance_sq * inv_range * inv_range;
+        float window = std::clamp(1.0f - ratio_sq * ratio_sq, 0.0f, 1.0f);
+        return window * window / (distance_sq + 1.0f);
+    }
+
+    // ׶˥(lx, ly, lz) ǴӱָԴĵλ
+    inline float SpotAttenuation(const LocalLight& light, float lx, float ly, float lz) {
+        float cos_angle = -(lx * light.direction.x() + ly * light.direction.y() + lz * light.direction.z());
+        float t = std::clamp(cos_angle * light.spotScale + light.spotOffset, 0.0f, 1.0f);
+        return t * t;
+    }
+}
@@ -3,6 +3,7 @@
 #include "../math/Vector.h"
 #include "../renderer/IShader.h"
 #include "Texture.h"
+#include "RenderState.h"
 
 namespace Morpheus::Renderer {
 
@@ -26,6 +27,8 @@ namespace Morpheus::Renderer {
         // δ:
         std::shared_ptr<IShader> shader;
 		float alpha_factor = 1.0f; 
+        // ɫʣƵ͵Ĳʿÿ 2x2  4x4 ֻɫһ ( ShadingRate)
+        ShadingRate shading_rate = ShadingRate::Rate1x1;
         // std::shared_ptr<Texture> albedoMap;
         // float roughness;
         // float metallic;
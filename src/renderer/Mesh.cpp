@@ -1,10 +1,14 @@
 #include "Mesh.h"
+#include "ObjReader.h"
+#include "../core/MappedFile.h"
 #include <stdexcept>
+#include <fstream>
+#include <filesystem>
+#include <optional>
+#include <algorithm>
+#include <cstring>
 #include <SDL.h>
 
-// ֻʵֺ
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>
 
 namespace Morpheus::Renderer {
     void CalculateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
@@ -63,60 +67,165 @@ namespace Morpheus::Renderer {
         }
     }
 
-    Mesh Mesh::LoadFromObj(const std::string& filepath) {
+    // --- 񻺴 (.mmsh) ---
+    // : [MeshCacheHeader][Vertex ][uint32_t ]鶼 64 ֽڶ룬
+    // ӳֱ֮Ӱļݵ Vertex/uint32_t ʹãҪκο
+    // 水ֽд룬ֻڱ٣ڷַ
+    struct MeshCacheHeader {
+        char magic[4];             // "MMSH"
+        uint32_t version;
+        uint32_t vertexStride;     // sizeof(Vertex)ṹ仯ʱԶʧЧ
+        uint32_t reserved;
+        uint64_t sourceSize;       // Դ OBJ ĴС޸ʱ䣬κһ仯Ϊ
+        int64_t sourceTimestamp;
+        uint64_t vertexCount;
+        uint64_t indexCount;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        float boundsMin[3];
+        float boundsMax[3];
+    };
+
+    constexpr uint32_t MESH_CACHE_VERSION = 2;
+    constexpr uint64_t MESH_CACHE_ALIGNMENT = 64;
+
+    uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // ͷ¼ (offset  count  stride ֽڵԪ) Ƿļ
+    // ˷ͼӷܱ𻵵ͷóȽ
+    bool ArrayFits(uint64_t offset, uint64_t count, uint64_t stride, uint64_t fileSize) {
+        if (offset < sizeof(MeshCacheHeader) || offset % MESH_CACHE_ALIGNMENT != 0 || offset > fileSize) return false;
+        return count <= (fileSize - offset) / stride;
+    }
+
+    // ȡԴļĴС޸ʱ䣬ʧܷ false
+    bool GetSourceStamp(const std::string& filepath, uint64_t& size, int64_t& timestamp) {
+        std::error_code ec;
+        size = std::filesystem::file_size(filepath, ec);
+        if (ec) return false;
+        auto time = std::filesystem::last_write_time(filepath, ec);
+        if (ec) return false;
+        timestamp = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    void ComputeBounds(Mesh& mesh) {
+        if (mesh.vertices.empty()) return;
+        mesh.boundsMin = mesh.vertices[0].position;
+        mesh.boundsMax = mesh.vertices[0].position;
+        for (const Vertex& v : mesh.vertices) {
+            for (int i = 0; i < 3; ++i) {
+                mesh.boundsMin[i] = std::min(mesh.boundsMin[i], v.position[i]);
+                mesh.boundsMax[i] = std::max(mesh.boundsMax[i], v.position[i]);
+            }
+        }
+    }
+
+    // ӳ仺ļ治ڡ𻵻ʱؿ
+    std::optional<Mesh> LoadMeshCache(const std::string& filepath, const std::string& cachePath) {
+        uint64_t source_size = 0;
+        int64_t source_time = 0;
+        if (!GetSourceStamp(filepath, source_size, source_time)) return std::nullopt;
+
+        auto file = Core::MappedFile::Open(cachePath);
+        if (!file || file->GetSize() < sizeof(MeshCacheHeader)) return std::nullopt;
+
+        MeshCacheHeader header;
+        std::memcpy(&header, file->GetData(), sizeof(header));
+        if (std::memcmp(header.magic, "MMSH", 4) != 0 ||
+            header.version != MESH_CACHE_VERSION ||
+            header.vertexStride != sizeof(Vertex) ||
+            header.sourceSize != source_size ||
+            header.sourceTimestamp != source_time) {
+            return std::nullopt;
+        }
+        if (!ArrayFits(header.vertexOffset, header.vertexCount, sizeof(Vertex), file->GetSize()) ||
+            !ArrayFits(header.indexOffset, header.indexCount, sizeof(uint32_t), file->GetSize())) {
+            SDL_Log("Warning: Mesh cache '%s' is truncated or corrupt, ignoring it.", cachePath.c_str());
+            return std::nullopt;
+        }
+
         Mesh mesh;
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
-        std::string warn, err;
-
-        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str())) {
-            // ôӡ
-            if (!warn.empty()) {
-                // std::cout << "TinyObjLoader Warning: " << warn << std::endl;
+        const unsigned char* base = file->GetData();
+        mesh.vertices = MeshBuffer<Vertex>(reinterpret_cast<const Vertex*>(base + header.vertexOffset), header.vertexCount, file);
+        mesh.indices = MeshBuffer<uint32_t>(reinterpret_cast<const uint32_t*>(base + header.indexOffset), header.indexCount, file);
+        mesh.boundsMin = { header.boundsMin[0], header.boundsMin[1], header.boundsMin[2] };
+        mesh.boundsMax = { header.boundsMax[0], header.boundsMax[1], header.boundsMax[2] };
+        return mesh;
+    }
+
+    // д棺д̶еʱļ̶дһļдʧֻӡ沢ɾʱļ
+    void WriteMeshCache(const Mesh& mesh, const std::string& filepath, const std::string& cachePath) {
+        MeshCacheHeader header{};
+        std::memcpy(header.magic, "MMSH", 4);
+        header.version = MESH_CACHE_VERSION;
+        header.vertexStride = sizeof(Vertex);
+        if (!GetSourceStamp(filepath, header.sourceSize, header.sourceTimestamp)) return;
+        header.vertexCount = mesh.vertices.size();
+        header.indexCount = mesh.indices.size();
+        header.vertexOffset = AlignUp(sizeof(MeshCacheHeader), MESH_CACHE_ALIGNMENT);
+        header.indexOffset = AlignUp(header.vertexOffset + header.vertexCount * sizeof(Vertex), MESH_CACHE_ALIGNMENT);
+        for (int i = 0; i < 3; ++i) {
+            header.boundsMin[i] = mesh.boundsMin[i];
+            header.boundsMax[i] = mesh.boundsMax[i];
+        }
+
+        const std::string temp_path = Core::MakeTempPath(cachePath);
+        std::error_code ec;
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                SDL_Log("Warning: Could not write mesh cache '%s'.", cachePath.c_str());
+                return;
             }
-            if (!err.empty()) {
-                throw std::runtime_error("TinyObjLoader Error: " + err);
+            const char zeros[MESH_CACHE_ALIGNMENT] = {};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(zeros, header.vertexOffset - sizeof(header));
+            out.write(reinterpret_cast<const char*>(mesh.vertices.data()), header.vertexCount * sizeof(Vertex));
+            out.write(zeros, header.indexOffset - (header.vertexOffset + header.vertexCount * sizeof(Vertex)));
+            out.write(reinterpret_cast<const char*>(mesh.indices.data()), header.indexCount * sizeof(uint32_t));
+            out.close();
+            if (!out) {
+                SDL_Log("Warning: Could not write mesh cache '%s'.", cachePath.c_str());
+                std::filesystem::remove(temp_path, ec);
+                return;
             }
-            throw std::runtime_error("Failed to load OBJ file for unknown reasons.");
         }
-        if (attrib.normals.empty()) {
-            SDL_Log("Warning: Mesh '%s' has no normals in file!", filepath.c_str());
+
+        std::filesystem::rename(temp_path, cachePath, ec);
+        if (ec) {
+            SDL_Log("Warning: Could not write mesh cache '%s': %s", cachePath.c_str(), ec.message().c_str());
+            std::filesystem::remove(temp_path, ec);
         }
+    }
 
-        // ж
-        for (const auto& shape : shapes) {
-            for (const auto& index : shape.mesh.indices) {
-                Vertex vertex{};
-                vertex.position = {
-                    attrib.vertices[3 * index.vertex_index + 0],
-                    attrib.vertices[3 * index.vertex_index + 1],
-                    attrib.vertices[3 * index.vertex_index + 2]
-                };
-
-                // --- طߵĴ ---
-                if (index.normal_index >= 0) {
-                    vertex.normal = {
-                        attrib.normals[3 * index.normal_index + 0],
-                        attrib.normals[3 * index.normal_index + 1],
-                        attrib.normals[3 * index.normal_index + 2]
-                    };
-                }
-
-                if (index.texcoord_index >= 0) {
-                    vertex.texCoords = {
-                        attrib.texcoords[2 * index.texcoord_index + 0],
-                        attrib.texcoords[2 * index.texcoord_index + 1]
-                    };
-                }
-
-                mesh.vertices.push_back(vertex);
-                // ע⣺OBJļͨÿжĶ㣬ֱ
-                mesh.indices.push_back(mesh.indices.size());
-            }
+    Mesh Mesh::Load(const std::string& filepath) {
+        std::string cache_path = filepath + ".mmsh";
+        if (std::optional<Mesh> cached = LoadMeshCache(filepath, cache_path)) {
+            SDL_Log("Mapped mesh cache: %s", cache_path.c_str());
+            return std::move(*cached);
         }
-        CalculateTangents(mesh.vertices, mesh.indices);
+
+        Mesh mesh = LoadFromObj(filepath);
+        WriteMeshCache(mesh, filepath, cache_path);
+        return mesh;
+    }
+
+    Mesh Mesh::LoadFromObj(const std::string& filepath) {
+        Mesh mesh;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+
+        // ʽֱӵõȥغĶ (ʧʱ׳ std::runtime_error)
+        ReadObj(filepath, vertices, indices);
+        CalculateTangents(vertices, indices);
         SDL_Log("Calculated tangents for mesh: %s", filepath.c_str());
+
+        mesh.vertices = MeshBuffer<Vertex>(std::move(vertices));
+        mesh.indices = MeshBuffer<uint32_t>(std::move(indices));
+        ComputeBounds(mesh);
         return mesh;
     }
 
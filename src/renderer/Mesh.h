@@ -3,17 +3,60 @@
 #include "../math/Vector.h"
 #include <vector>
 #include <string>
+#include <memory>
+#include <cassert>
 #include "Vertex.h"
 
 // ֻͷļʵ֣
-// Ҫ tiny_obj_loader.hΪʵϸڱ .cpp ļ
+// Ҫ OBJ ͷļΪʵϸڱ .cpp ļ
 // һָõķװʵԼͷļͱʱ
 
 namespace Morpheus::Renderer {
+
+    // --- / ---
+    // ȿԼ ( OBJ õ)Ҳֻһͼֱָڴӳ񻺴ļ (㿽)
+    template<typename T>
+    class MeshBuffer {
+    public:
+        MeshBuffer() = default;
+        explicit MeshBuffer(std::vector<T>&& owned) : m_owned(std::move(owned)) {}
+        // backing ֤ӳͼڼ䲻ᱻͷ
+        MeshBuffer(const T* data, size_t count, std::shared_ptr<const void> backing)
+            : m_view(data), m_viewSize(count), m_backing(std::move(backing)) {
+        }
+
+        const T* data() const { return m_backing ? m_view : m_owned.data(); }
+        size_t size() const { return m_backing ? m_viewSize : m_owned.size(); }
+        bool empty() const { return size() == 0; }
+
+        const T& operator[](size_t i) const {
+            assert(i < size());
+            return data()[i];
+        }
+        const T* begin() const { return data(); }
+        const T* end() const { return data() + size(); }
+
+        // Ƿֱӳļ
+        bool IsMapped() const { return m_backing != nullptr; }
+
+    private:
+        std::vector<T> m_owned;
+        const T* m_view = nullptr;
+        size_t m_viewSize = 0;
+        std::shared_ptr<const void> m_backing;
+    };
+
     class Mesh {
     public:
-        std::vector<Vertex> vertices;
-        std::vector<uint32_t> indices;
+        MeshBuffer<Vertex> vertices;
+        MeshBuffer<uint32_t> indices;
+
+        // ģͿռΧ
+        Math::Vector3f boundsMin{ 0.0f, 0.0f, 0.0f };
+        Math::Vector3f boundsMax{ 0.0f, 0.0f, 0.0f };
+
+        // ʹ OBJ ԱߵĶƻ (<obj>.mmsh)ȱʧʱ½ OBJ дػ
+        static Mesh Load(const std::string& filepath);
 
         // ֻкԷֺŽβ
         static Mesh LoadFromObj(const std::string& filepath);
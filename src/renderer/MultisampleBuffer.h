@@ -0,0 +1,126 @@
+// src/renderer/MultisampleBuffer.h (ļ)
+#pragma once
+#include "Framebuffer.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Morpheus::Renderer {
+
+    // --- ز (4x MSAA) ---
+    // ÿ 4 㣬Ⱥɫ (ʽ Framebuffer ͬ)ƬԪɫÿֻһΣ
+    // дθǲͨȲԵĲϣ֡ʱ߿ƽ֡ء
+    // 洢߿ (߿ȣͬһصĲ㰤һ)һ߿Ĳһڴ棬
+    // դ̴߳һ߿ʱֻһ (64x64 ߿ɫȹ 128KBڶ)
+    //  TileBuffer һӳٵģ߿һҪʱ䣬û߿ϳʱֱֵ
+    // Ե߿ҲС䣬֡ĲֲᱻдҲᱻϳ
+    class MultisampleBuffer {
+    public:
+        static constexpr int SAMPLE_COUNT = 4;
+        // ĵƫ ()׼ 4x תˮƽʹֱ϶ 4 ͬλ
+        static constexpr float SAMPLE_OFFSETS[SAMPLE_COUNT][2] = {
+            { -0.125f, -0.375f }, { 0.375f, -0.125f }, { -0.375f, 0.125f }, { 0.125f, 0.375f },
+        };
+
+        void Resize(size_t tile_count, int tile_size) {
+            m_tileCount = tile_count;
+            m_tileSize = tile_size;
+            m_tileStride = (size_t)tile_size * tile_size * SAMPLE_COUNT;
+            m_depth.assign(tile_count * m_tileStride, 1.0f);
+            m_color.assign(tile_count * m_tileStride, 0u);
+            m_pending.assign(tile_count, 0);
+        }
+
+        size_t GetTileCount() const { return m_tileCount; }
+        int GetTileSize() const { return m_tileSize; }
+
+        // ߿ (lx, ly) ĵһ߿±꣬
+        size_t PixelOffset(int lx, int ly) const { return ((size_t)ly * m_tileSize + lx) * SAMPLE_COUNT; }
+        float* TileDepth(size_t tile_index) { return m_depth.data() + tile_index * m_tileStride; }
+        uint32_t* TileColor(size_t tile_index) { return m_color.data() + tile_index * m_tileStride; }
+        const float* TileDepth(size_t tile_index) const { return m_depth.data() + tile_index * m_tileStride; }
+
+        // ߿Ϊ (ÿ֡ʼʱ)
+        void DeferClear(uint32_t color, float depth) {
+            m_clearColor = color;
+            m_clearDepth = depth;
+            std::fill(m_pending.begin(), m_pending.end(), uint8_t(1));
+        }
+        // ߿黹ûʱв㣬д߿֮ǰ (ֻɸ߿̵߳)
+        void TouchTile(size_t tile_index) {
+            if (!m_pending[tile_index]) return;
+            std::fill_n(TileDepth(tile_index), m_tileStride, m_clearDepth);
+            std::fill_n(TileColor(tile_index), m_tileStride, m_clearColor);
+            m_pending[tile_index] = 0;
+        }
+
+        // ߿ (طΧ [minX, maxX) x [minY, maxY)) ϳɵ framebufferɫȡƽȡĲ
+        void ResolveTile(size_t tile_index, Framebuffer& framebuffer, int minX, int minY, int maxX, int maxY) const {
+            if (m_pending[tile_index]) {
+                for (int y = minY; y < maxY; ++y) {
+                    std::fill_n(framebuffer.GetColorRow(y) + minX, maxX - minX, m_clearColor);
+                    std::fill_n(framebuffer.GetDepthRow(y) + minX, maxX - minX, m_clearDepth);
+                }
+                return;
+            }
+            const float* tile_depth = m_depth.data() + tile_index * m_tileStride;
+            const uint32_t* tile_color = m_color.data() + tile_index * m_tileStride;
+            for (int y = minY; y < maxY; ++y) {
+                uint32_t* color_row = framebuffer.GetColorRow(y);
+                float* depth_row = framebuffer.GetDepthRow(y);
+                const size_t row_offset = PixelOffset(0, y - minY);
+                for (int x = minX; x < maxX; ++x) {
+                    const size_t p = row_offset + (size_t)(x - minX) * SAMPLE_COUNT;
+                    color_row[x] = AverageColor(tile_color + p);
+                    const float* depth = tile_depth + p;
+                    depth_row[x] = std::min(std::min(depth[0], depth[1]), std::min(depth[2], depth[3]));
+                }
+            }
+        }
+
+        // ߿ (Ͻ width x height ) вȷΧskip_cleared ʱûмεĲ ( >= 1)
+        void DepthRange(size_t tile_index, int width, int height, bool skip_cleared, float& nearest, float& farthest) const {
+            if (m_pending[tile_index]) {
+                if (skip_cleared && m_clearDepth >= 1.0f) return;
+                nearest = std::min(nearest, m_clearDepth);
+                farthest = std::max(farthest, m_clearDepth);
+                return;
+            }
+            const float* tile_depth = TileDepth(tile_index);
+            for (int ly = 0; ly < height; ++ly) {
+                const float* depth = tile_depth + PixelOffset(0, ly);
+                for (int i = 0; i < width * SAMPLE_COUNT; ++i) {
+                    if (skip_cleared && depth[i] >= 1.0f) continue;
+                    nearest = std::min(nearest, depth[i]);
+                    farthest = std::max(farthest, depth[i]);
+                }
+            }
+        }
+
+        // 4 ɫͨƽ ()ڲ 4 ֱͬӷ
+        static uint32_t AverageColor(const uint32_t* samples) {
+            static_assert(SAMPLE_COUNT == 4, "AverageColor divides by shifting");
+            const uint32_t c0 = samples[0];
+            if (samples[1] == c0 && samples[2] == c0 && samples[3] == c0) return c0;
+            // ͨһ 32 λӣÿͨĺͲ 4 * 255λͨ
+            uint32_t rb = 0, ag = 0;
+            for (int s = 0; s < SAMPLE_COUNT; ++s) {
+                rb += samples[s] & 0x00FF00FFu;
+                ag += (samples[s] >> 8) & 0x00FF00FFu;
+            }
+            rb = ((rb + 0x00020002u) >> 2) & 0x00FF00FFu;
+            ag = ((ag + 0x00020002u) >> 2) & 0x00FF00FFu;
+            return rb | (ag << 8);
+        }
+
+    private:
+        size_t m_tileCount = 0;
+        int m_tileSize = 0;
+        size_t m_tileStride = 0; // һ߿Ĳ
+        std::vector<float> m_depth;
+        std::vector<uint32_t> m_color;
+        std::vector<uint8_t> m_pending; // ÿ߿һǣդʱɸ߿߳д
+        uint32_t m_clearColor = 0;
+        float m_clearDepth = 1.0f;
+    };
+}
@@ -0,0 +1,103 @@
+// src/renderer/OITBuffer.h (ļ)
+#pragma once
+#include "Framebuffer.h"
+#include <algorithm>
+#include <vector>
+
+namespace Morpheus::Renderer {
+
+    // --- Ȩϵ˳޹͸ (Weighted Blended OIT, McGuire & Bavoil 2013) ---
+    // ÿۼӣƬԪ˳޹أ԰͸βҪ򣬿ԺͲ͸һ߿鲢йդ
+    //   accum     sum(color * alpha * weight), sum(alpha * weight)
+    //   revealage prod(1 - alpha)͸ı
+    // ϳʱ color = accum.rgb / accum.a * (1 - revealage) +  * revealage
+    // ֻһ͸ʱͨ Alpha ȫͬصʱȼȨƣƬԪȨظ
+    // Լ Framebuffer ͬ (y )± y * width + x
+    // زʱ revealage ֿ棺θһصһʱÿȻֻһ (1 - alpha)
+    // ƽ֮رһθǵĽͬεĹϲֽӷ
+    class OITBuffer {
+    public:
+        void Resize(int width, int height, int samples = 1) {
+            m_width = width;
+            m_height = height;
+            m_samples = samples;
+            const size_t count = (size_t)width * height;
+            m_accum.assign(count, Math::Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f });
+            m_revealage.assign(count * samples, 1.0f);
+        }
+
+        // Ȩ (еʽ 7)view_depth ǵľ
+        static float Weight(float alpha, float view_depth) {
+            float a = view_depth * (1.0f / 5.0f);
+            float b = view_depth * (1.0f / 200.0f);
+            float b2 = b * b;
+            return alpha * std::clamp(10.0f / (1e-5f + a * a + b2 * b2 * b2), 1e-2f, 3e3f);
+        }
+
+        // ֤߱ڷΧ (դʱÿֻɸ߿߳д)
+        // sample_mask ƬԪɼĲ (زʱ)ɫɼıۼ
+        void Accumulate(int x, int y, const Math::Vector4f& color, float view_depth, uint32_t sample_mask = 1) {
+            const size_t index = (size_t)y * m_width + x;
+            const float alpha = color.w();
+            float weight = Weight(alpha, view_depth);
+            if (m_samples == 1) {
+                m_revealage[index] *= 1.0f - alpha;
+            }
+            else {
+                int visible = 0;
+                for (int s = 0; s < m_samples; ++s) {
+                    if (!((sample_mask >> s) & 1u)) continue;
+                    m_revealage[index * m_samples + s] *= 1.0f - alpha;
+                    visible++;
+                }
+                weight *= (float)visible / (float)m_samples;
+            }
+            Math::Vector4f& accum = m_accum[index];
+            accum.x() += color.x() * alpha * weight;
+            accum.y() += color.y() * alpha * weight;
+            accum.z() += color.z() * alpha * weight;
+            accum.w() += alpha * weight;
+        }
+
+        //  [minX, maxX) x [minY, maxY) ۼӵĽϳɵ framebuffer ɫϣλһ֡Ҫ
+        void Resolve(Framebuffer& framebuffer, int minX, int minY, int maxX, int maxY) {
+            for (int y = minY; y < maxY; ++y) {
+                for (int x = minX; x < maxX; ++x) {
+                    const size_t index = (size_t)y * m_width + x;
+                    Math::Vector4f& accum = m_accum[index];
+                    if (accum.w() <= 0.0f) continue; // ûа͸ƬԪ
+                    float* sample_revealage = m_revealage.data() + index * m_samples;
+                    float revealage = 0.0f;
+                    for (int s = 0; s < m_samples; ++s) {
+                        revealage += sample_revealage[s];
+                        sample_revealage[s] = 1.0f;
+                    }
+                    revealage /= (float)m_samples;
+
+                    const float inv_weight = 1.0f / std::max(accum.w(), 1e-5f);
+                    const float coverage = 1.0f - revealage;
+                    Math::Vector4f dst = framebuffer.GetColor(x, y);
+                    framebuffer.SetColor(x, y, {
+                        accum.x() * inv_weight * coverage + dst.x() * revealage,
+                        accum.y() * inv_weight * coverage + dst.y() * revealage,
+                        accum.z() * inv_weight * coverage + dst.z() * revealage,
+                        coverage + dst.w() * revealage
+                        });
+
+                    accum = Math::Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
+                }
+            }
+        }
+
+        int GetWidth() const { return m_width; }
+        int GetHeight() const { return m_height; }
+        int GetSampleCount() const { return m_samples; }
+
+    private:
+        int m_width = 0;
+        int m_height = 0;
+        int m_samples = 1;
+        std::vector<Math::Vector4f> m_accum;
+        std::vector<float> m_revealage;
+    };
+}
@@ -0,0 +1,283 @@
+// src/renderer/ObjReader.cpp (ļ)
+#include "ObjReader.h"
+#include "Mesh.h"
+#include "../core/MappedFile.h"
+#include "../core/ThreadPool.h"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <SDL.h>
+
+namespace Morpheus::Renderer {
+
+    constexpr int32_t OBJ_MISSING_INDEX = std::numeric_limits<int32_t>::min();
+    constexpr uint32_t OBJ_NO_VERTEX = std::numeric_limits<uint32_t>::max();
+    constexpr size_t OBJ_MIN_CHUNK_SIZE = 1 << 20; // 1 MB̫СĿ鲻ֵ÷ָ߳
+
+    // ϵһǣλ//Ե± ( 0 ʼ)
+    // OBJ ĸ "ĿǰΪֹ" ģֿ鲢нʱ֪ǰĿжԣ
+    // ȼǳɿ±겢 relative ǣϲʱټϿĻַ
+    struct ObjCorner {
+        int32_t index[3];  // 0: position, 1: texcoord, 2: normal
+        uint8_t relative;  //  k λΪ 1 ʾ index[k] ǿ±
+    };
+
+    // һ飺ļеһУԼЩԺ
+    struct ObjChunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        std::vector<float> positions;  // xyz
+        std::vector<float> texcoords;  // uv
+        std::vector<float> normals;    // xyz
+        std::vector<ObjCorner> corners; // Ѿǻÿ 3 һ
+        std::string error;
+    };
+
+    const char* ObjSkipSpaces(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        return p;
+    }
+
+    bool ObjParseFloat(const char*& p, const char* end, float& out) {
+        p = ObjSkipSpaces(p, end);
+        if (p < end && *p == '+') ++p;
+        auto result = std::from_chars(p, end, out);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    bool ObjParseInt(const char*& p, const char* end, int& out) {
+        if (p < end && *p == '+') ++p;
+        auto result = std::from_chars(p, end, out);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    //  OBJ  ( 1 ʼĩβ) ת ObjCorner ıʾ
+    bool ObjResolveIndex(int value, size_t localCount, ObjCorner& corner, int k) {
+        if (value > 0) {
+            corner.index[k] = value - 1;
+        }
+        else if (value < 0) {
+            corner.index[k] = static_cast<int32_t>(static_cast<int64_t>(localCount) + value);
+            corner.relative |= static_cast<uint8_t>(1 << k);
+        }
+        else {
+            return false; // OBJ Ϊ 0
+        }
+        return true;
+    }
+
+    // һ "v", "v/vt", "v//vn"  "v/vt/vn" ʽ涥
+    bool ObjParseCorner(const char*& p, const char* end, const ObjChunk& chunk, ObjCorner& corner) {
+        corner.index[0] = corner.index[1] = corner.index[2] = OBJ_MISSING_INDEX;
+        corner.relative = 0;
+
+        int value = 0;
+        if (!ObjParseInt(p, end, value) || !ObjResolveIndex(value, chunk.positions.size() / 3, corner, 0)) return false;
+        if (p < end && *p == '/') {
+            ++p;
+            if (p < end && *p != '/') {
+                if (!ObjParseInt(p, end, value) || !ObjResolveIndex(value, chunk.texcoords.size() / 2, corner, 1)) return false;
+            }
+            if (p < end && *p == '/') {
+                ++p;
+                if (!ObjParseInt(p, end, value) || !ObjResolveIndex(value, chunk.normals.size() / 3, corner, 2)) return false;
+            }
+        }
+        return true;
+    }
+
+    void ParseObjChunk(ObjChunk& chunk) {
+        std::vector<ObjCorner> polygon;
+        const char* p = chunk.begin;
+        while (p < chunk.end) {
+            const char* line_end = static_cast<const char*>(std::memchr(p, '\n', chunk.end - p));
+            if (!line_end) line_end = chunk.end;
+            const char* line_begin = p;
+            const char* q = ObjSkipSpaces(p, line_end);
+            p = line_end + 1;
+
+            if (line_end - q < 2) continue;
+            bool ok = true;
+            if (q[0] == 'v' && (q[1] == ' ' || q[1] == '\t')) {
+                float x, y, z;
+                q += 1;
+                ok = ObjParseFloat(q, line_end, x) && ObjParseFloat(q, line_end, y) && ObjParseFloat(q, line_end, z);
+                if (ok) chunk.positions.insert(chunk.positions.end(), { x, y, z });
+            }
+            else if (q[0] == 'v' && q[1] == 't') {
+                float u, v = 0.0f;
+                q += 2;
+                ok = ObjParseFloat(q, line_end, u);
+                if (ok && ObjSkipSpaces(q, line_end) < line_end) ok = ObjParseFloat(q, line_end, v);
+                if (ok) chunk.texcoords.insert(chunk.texcoords.end(), { u, v });
+            }
+            else if (q[0] == 'v' && q[1] == 'n') {
+                float x, y, z;
+                q += 2;
+                ok = ObjParseFloat(q, line_end, x) && ObjParseFloat(q, line_end, y) && ObjParseFloat(q, line_end, z);
+                if (ok) chunk.normals.insert(chunk.normals.end(), { x, y, z });
+            }
+            else if (q[0] == 'f' && (q[1] == ' ' || q[1] == '\t')) {
+                polygon.clear();
+                q += 1;
+                for (q = ObjSkipSpaces(q, line_end); ok && q < line_end; q = ObjSkipSpaces(q, line_end)) {
+                    ObjCorner corner;
+                    ok = ObjParseCorner(q, line_end, chunk, corner);
+                    if (ok) polygon.push_back(corner);
+                }
+                ok = ok && polygon.size() >= 3;
+                // ǻ
+                for (size_t i = 1; ok && i + 1 < polygon.size(); ++i) {
+                    chunk.corners.push_back(polygon[0]);
+                    chunk.corners.push_back(polygon[i]);
+                    chunk.corners.push_back(polygon[i + 1]);
+                }
+            }
+
+            if (!ok) {
+                chunk.error = "malformed line '" + std::string(line_begin, line_end) + "'";
+                return;
+            }
+        }
+    }
+
+    void ReadObj(const std::string& filepath, std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices) {
+        auto file = Core::MappedFile::Open(filepath);
+        if (!file) {
+            throw std::runtime_error("Failed to open OBJ file: " + filepath);
+        }
+
+        // --- 1. б߽п ---
+        auto& pool = Core::ThreadPool::Get();
+        const char* data = reinterpret_cast<const char*>(file->GetData());
+        const char* data_end = data + file->GetSize();
+        size_t chunk_size = std::max(OBJ_MIN_CHUNK_SIZE, file->GetSize() / (static_cast<size_t>(pool.GetThreadCount()) * 4 + 1));
+
+        std::vector<ObjChunk> chunks;
+        for (const char* p = data; p < data_end;) {
+            const char* end = p + std::min(chunk_size, static_cast<size_t>(data_end - p));
+            const char* newline = end < data_end ? static_cast<const char*>(std::memchr(end, '\n', data_end - end)) : nullptr;
+            end = newline ? newline + 1 : data_end;
+            ObjChunk chunk;
+            chunk.begin = p;
+            chunk.end = end;
+            chunks.push_back(std::move(chunk));
+            p = end;
+        }
+
+        // --- 2. нÿ ---
+        pool.ParallelFor(chunks.size(), [&](size_t i) { ParseObjChunk(chunks[i]); });
+        for (const auto& chunk : chunks) {
+            if (!chunk.error.empty()) {
+                throw std::runtime_error("OBJ parse error in " + filepath + ": " + chunk.error);
+            }
+        }
+
+        // --- 3. ϲԣ¼ÿĻַ ---
+        std::vector<float> positions, texcoords, normals;
+        std::vector<size_t> position_base(chunks.size()), texcoord_base(chunks.size()), normal_base(chunks.size());
+        size_t total_corners = 0;
+        {
+            size_t np = 0, nt = 0, nn = 0;
+            for (const auto& chunk : chunks) {
+                np += chunk.positions.size();
+                nt += chunk.texcoords.size();
+                nn += chunk.normals.size();
+                total_corners += chunk.corners.size();
+            }
+            positions.reserve(np);
+            texcoords.reserve(nt);
+            normals.reserve(nn);
+        }
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            position_base[i] = positions.size() / 3;
+            texcoord_base[i] = texcoords.size() / 2;
+            normal_base[i] = normals.size() / 3;
+            positions.insert(positions.end(), chunks[i].positions.begin(), chunks[i].positions.end());
+            texcoords.insert(texcoords.end(), chunks[i].texcoords.begin(), chunks[i].texcoords.end());
+            normals.insert(normals.end(), chunks[i].normals.begin(), chunks[i].normals.end());
+            // ڵѾߣͷ
+            std::vector<float>().swap(chunks[i].positions);
+            std::vector<float>().swap(chunks[i].texcoords);
+            std::vector<float>().swap(chunks[i].normals);
+        }
+        if (normals.empty()) {
+            SDL_Log("Warning: Mesh '%s' has no normals in file!", filepath.c_str());
+        }
+
+        // --- 4. ȥزдջ ---
+        // λ±Ϊͷѹͬһλõ㴮ʱֻȽ (vt, vn)
+        // ϣÿλ/ֻռ 4 ֽ
+        const size_t position_count = positions.size() / 3;
+        const size_t texcoord_count = texcoords.size() / 2;
+        const size_t normal_count = normals.size() / 3;
+        std::vector<uint32_t> first_vertex(position_count, OBJ_NO_VERTEX);
+        std::vector<uint32_t> next_vertex;
+        std::vector<std::pair<int32_t, int32_t>> vertex_attribs;
+
+        outVertices.clear();
+        outIndices.clear();
+        outIndices.reserve(total_corners);
+        outVertices.reserve(position_count);
+        next_vertex.reserve(position_count);
+        vertex_attribs.reserve(position_count);
+
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const size_t bases[3] = { position_base[c], texcoord_base[c], normal_base[c] };
+            const size_t counts[3] = { position_count, texcoord_count, normal_count };
+
+            for (const ObjCorner& corner : chunks[c].corners) {
+                int64_t resolved[3];
+                for (int k = 0; k < 3; ++k) {
+                    if (corner.index[k] == OBJ_MISSING_INDEX) {
+                        resolved[k] = -1;
+                        continue;
+                    }
+                    resolved[k] = corner.index[k];
+                    if (corner.relative & (1 << k)) resolved[k] += static_cast<int64_t>(bases[k]);
+                    if (resolved[k] < 0 || resolved[k] >= static_cast<int64_t>(counts[k])) {
+                        throw std::runtime_error("OBJ parse error in " + filepath + ": face index out of range");
+                    }
+                }
+
+                const size_t pos = static_cast<size_t>(resolved[0]);
+                const std::pair<int32_t, int32_t> key(static_cast<int32_t>(resolved[1]), static_cast<int32_t>(resolved[2]));
+                uint32_t vi = first_vertex[pos];
+                while (vi != OBJ_NO_VERTEX && vertex_attribs[vi] != key) {
+                    vi = next_vertex[vi];
+                }
+
+                if (vi == OBJ_NO_VERTEX) {
+                    if (outVertices.size() >= OBJ_NO_VERTEX) {
+                        throw std::runtime_error("OBJ parse error in " + filepath + ": too many vertices");
+                    }
+                    vi = static_cast<uint32_t>(outVertices.size());
+
+                    Vertex vertex{};
+                    vertex.position = { positions[3 * pos + 0], positions[3 * pos + 1], positions[3 * pos + 2] };
+                    if (key.second >= 0) {
+                        vertex.normal = { normals[3 * key.second + 0], normals[3 * key.second + 1], normals[3 * key.second + 2] };
+                    }
+                    if (key.first >= 0) {
+                        vertex.texCoords = { texcoords[2 * key.first + 0], texcoords[2 * key.first + 1] };
+                    }
+                    outVertices.push_back(vertex);
+                    vertex_attribs.push_back(key);
+                    next_vertex.push_back(first_vertex[pos]);
+                    first_vertex[pos] = vi;
+                }
+                outIndices.push_back(vi);
+            }
+            // Ѿдջ壬ͷ
+            std::vector<ObjCorner>().swap(chunks[c].corners);
+        }
+
+        outVertices.shrink_to_fit();
+    }
+}
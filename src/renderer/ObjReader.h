@@ -0,0 +1,16 @@
+// src/renderer/ObjReader.h (ļ)
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace Morpheus::Renderer {
+    struct Vertex;
+
+    // ʽ OBJ ȡ
+    // ļͨڴӳȡб߽гɿ齻̳߳زн
+    // ȻֱӰ (v, vt, vn) ȥдյĶ/壬м attrib/shape 顣
+    // ֻ v / vt / vn / fΰǻ (o, g, usemtl ) ԡ
+    // δ㣬ɵ߸𡣽ʧʱ׳ std::runtime_error
+    void ReadObj(const std::string& filepath, std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices);
+}
@@ -9,6 +9,7 @@
 namespace Morpheus::Renderer {
     class Framebuffer;
     class Texture;
+    struct DrawUniforms;
 }
 
 namespace Morpheus::Renderer {
@@ -21,9 +22,20 @@ namespace Morpheus::Renderer {
         DepthTestEnable = 1 << 1,  // ǷȲ
         CullFaceEnable = 1 << 2,  // Ƿñ޳
         BlendEnable = 1 << 3,  // Ƿ Alpha 
+        DepthOnly = 1 << 4,  // ֻд (Ӱͼ)ƬԪɫҲдɫ
+        GBufferWrite = 1 << 5,  // ӳɫ GBufferFragment д G-buffer ȣдɫ
+        OITAccumulate = 1 << 6,  // ˳޹͸ƬԪȨۼӵ OIT 壬а͸廭ͳһϳ (дȺɫ)
         // Ӹ־磺StencilTestEnable, WireframeEnable 
     };
 
+    // --- ɫ (ɱɫ) ---
+    // ƬԪɫÿ N x N صһΣظͬһɫǺȻءֵ N
+    enum class ShadingRate : uint8_t {
+        Rate1x1 = 1,
+        Rate2x2 = 2,
+        Rate4x4 = 4,
+    };
+
     // --- RenderState ṹ ---
     // ṹΪݸ RenderPass  Shader
     struct RenderState {
@@ -38,6 +50,17 @@ namespace Morpheus::Renderer {
         // Դ View-Projection ڽתԴĲüռ
         Math::Matrix4f lightViewProjectionMatrix;
 
+        // --- ƫ ( glPolygonOffset)νʱӵ ---
+        // ƫ = depthBiasSlope * Ļϵб (ÿ) + depthBiasConstantӰ Pass ڵ
+        float depthBiasSlope = 0.0f;
+        float depthBiasConstant = 0.0f;
+
+        // --- ɫʣԲʣȾĻռɫͼȡϴֵһ (ֻдɫĵЧ) ---
+        ShadingRate shadingRate = ShadingRate::Rate1x1;
+
+        // --- λƵ Uniforms (󡢲ʡƹ)Ⱦ֡ڷ ---
+        const DrawUniforms* uniforms = nullptr;
+
         // --- Ⱦģʽ־ ---
         //  RenderStateFlags
         // ʹ洢־λλ
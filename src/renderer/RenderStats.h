@@ -0,0 +1,57 @@
+// src/renderer/RenderStats.h (ļ)
+#pragma once
+#include <cstdint>
+
+namespace Morpheus::Renderer {
+
+    // ÿ֡Ⱦͳ
+    // ν׶߳ۼƣդ׶ÿ߿Լһ (ͬһʱֻһ߳ڴĳ߿飬ԲҪԭӲ)
+    // ֡ʱϲжϳ׿ڶ㡢ƬԪǴ
+    struct RenderStats {
+        // ---  ---
+        uint64_t trianglesSubmitted = 0;       // ͽü׶ε
+        uint64_t trianglesClipped = 0;         // ׶ཻ߽ü
+        uint64_t trianglesOutsideFrustum = 0;  // ȫ׶⡢ü
+        uint64_t trianglesBackfaceCulled = 0;  // ޳ (üμ)
+        uint64_t trianglesBinned = 0;          // һ߿Ⱦ
+        uint64_t tileBinEntries = 0;           // ߿бȾ
+
+        // --- ƬԪ ---
+        uint64_t fragmentsTested = 0;          // ǲͨȲԵƬԪ
+        uint64_t fragmentsDepthRejected = 0;   // ȲʧܵƬԪ (ִƬԪɫ)
+        uint64_t fragmentsShaded = 0;          // ִƬԪɫƬԪ
+        uint64_t fragmentsBlended = 0;         //  Alpha ϵƬԪ
+        uint64_t pixelsLit = 0;                // ӳɫĹ Pass ˹յ
+
+        // --- ֲԴ ---
+        uint64_t localLights = 0;              // ĵԴ;۹
+        uint64_t tileLightEntries = 0;         // ߿Դбĳ֮ (ӳɫÿ֡޳Σζ)
+
+        // --- Ӱ (ֻӰ Pass ͳ) ---
+        uint64_t shadowCascadesRendered = 0;   // »˾̬Ͷļ
+        uint64_t shadowCascadesCached = 0;     // ֱӸһ̬֡Ӱļ
+
+        // --- ÿ߿Ⱦ ---
+        uint32_t maxPacketsPerTile = 0;
+        float meanPacketsPerTile = 0.0f;
+
+        RenderStats& operator+=(const RenderStats& other) {
+            trianglesSubmitted += other.trianglesSubmitted;
+            trianglesClipped += other.trianglesClipped;
+            trianglesOutsideFrustum += other.trianglesOutsideFrustum;
+            trianglesBackfaceCulled += other.trianglesBackfaceCulled;
+            trianglesBinned += other.trianglesBinned;
+            tileBinEntries += other.tileBinEntries;
+            fragmentsTested += other.fragmentsTested;
+            fragmentsDepthRejected += other.fragmentsDepthRejected;
+            fragmentsShaded += other.fragmentsShaded;
+            fragmentsBlended += other.fragmentsBlended;
+            pixelsLit += other.pixelsLit;
+            localLights += other.localLights;
+            tileLightEntries += other.tileLightEntries;
+            shadowCascadesRendered += other.shadowCascadesRendered;
+            shadowCascadesCached += other.shadowCascadesCached;
+            return *this;
+        }
+    };
+}
@@ -4,122 +4,625 @@
 #include <algorithm>
 #include <vector>
 #include <cmath>
+#include <cfloat>
+#include <cstring>
 #include <iostream>
 #include "../scene/Scene.h"
 #include "IShader.h"
 #include "../renderer/Clipping.h"
+#include "shaders/BlinnPhongShader.h"
+#include "shaders/UnlitShader.h"
+#include "shaders/ShadowMapShader.h"
+#include "../core/ThreadPool.h"
+#include "../core/Profiler.h"
+#include "../core/FrameArena.h"
 #include <SDL.h>
 
 namespace Morpheus::Renderer {
 
+    // Ⱦ׶μʱ Profiler ¼һ¼ͬʱѺʱ () ۼӵ FrameTimings ĶӦֶ
+    class StageScope {
+    public:
+        StageScope(const char* name, float& targetMs)
+            : m_profile(name), m_targetMs(targetMs), m_start(std::chrono::steady_clock::now()) {
+        }
+        ~StageScope() {
+            m_targetMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+    private:
+        Core::ProfileScope m_profile;
+        float& m_targetMs;
+        std::chrono::steady_clock::time_point m_start;
+    };
 
     // --- 캯 ---
     Renderer::Renderer(int width, int height) {
         m_framebuffer = std::make_shared<Framebuffer>(width, height);
-        m_numThreads = std::thread::hardware_concurrency();
-        if (m_numThreads == 0) m_numThreads = 4;
+        m_numThreads = Core::ThreadPool::Get().GetThreadCount() + 1; // ߳ + ߳
         SDL_Log("Using %u threads for rendering.", m_numThreads);
 
-        const int TILE_SIZE = 64;
+        m_mainTarget.Init(m_framebuffer.get());
+    }
+
+    void Renderer::RenderTarget::Init(Framebuffer* target) {
+        framebuffer = target;
+        const int width = target->GetWidth();
+        const int height = target->GetHeight();
+        columns = (width + TILE_SIZE - 1) / TILE_SIZE;
+        rows = (height + TILE_SIZE - 1) / TILE_SIZE;
+        tiles.clear();
         for (int y = 0; y < height; y += TILE_SIZE) {
             for (int x = 0; x < width; x += TILE_SIZE) {
-                m_tiles.push_back({
+                tiles.push_back({
                     x, y,
                     std::min(x + TILE_SIZE, width),
                     std::min(y + TILE_SIZE, height)
                     });
             }
         }
-        // Ϊ m_tilePackets Ԥռ
-        m_tilePackets.resize(m_tiles.size());
+        tileStats.assign(tiles.size(), RenderStats());
+        tilePacketCounts.assign(tiles.size(), 0u);
+    }
+
+    void Renderer::RenderTarget::ResetStats() {
+        std::fill(tileStats.begin(), tileStats.end(), RenderStats());
+        std::fill(tilePacketCounts.begin(), tilePacketCounts.end(), 0u);
+    }
+
+    void Renderer::RenderTarget::MergeStats(RenderStats& out) const {
+        uint64_t total_packets = 0;
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            out += tileStats[i];
+            out.maxPacketsPerTile = std::max(out.maxPacketsPerTile, tilePacketCounts[i]);
+            total_packets += tilePacketCounts[i];
+        }
+        out.meanPacketsPerTile = tiles.empty() ? 0.0f : (float)total_packets / (float)tiles.size();
+    }
+
+    void Renderer::SetShadowMapSize(int size) {
+        if (size <= 0 || size > INT16_MAX) {
+            SDL_Log("Invalid shadow map size %d, keeping %d", size, m_shadowMapSize);
+            return;
+        }
+        if (size == m_shadowMapSize) return;
+        m_shadowMapSize = size;
+        m_shadowTargets.clear(); // һ֡³ߴ´
+    }
+
+    void Renderer::SetTemporalAA(bool enabled) {
+        if (enabled && !m_temporalAA) m_temporalBuffer.Invalidate(); // رڼ֡Ϊʷ
+        m_temporalAA = enabled;
+    }
+
+    void Renderer::SetShadingRateImage(std::vector<ShadingRate> rates) {
+        if (!rates.empty() && rates.size() != m_mainTarget.tiles.size()) {
+            SDL_Log("Shading rate image has %zu entries, expected %zu (one per tile), ignoring it", rates.size(), m_mainTarget.tiles.size());
+            rates.clear();
+        }
+        m_shadingRateImage = std::move(rates);
+    }
+
+    std::vector<ShadingRate> Renderer::MakePeripheralShadingRateImage(float inner, float outer) const {
+        const float half_width = 0.5f * (float)m_framebuffer->GetWidth();
+        const float half_height = 0.5f * (float)m_framebuffer->GetHeight();
+        const float inv_half_diagonal = 1.0f / std::sqrt(half_width * half_width + half_height * half_height);
+        std::vector<ShadingRate> rates;
+        rates.reserve(m_mainTarget.tiles.size());
+        for (const Tile& tile : m_mainTarget.tiles) {
+            const float dx = 0.5f * (float)(tile.minX + tile.maxX) - half_width;
+            const float dy = 0.5f * (float)(tile.minY + tile.maxY) - half_height;
+            const float distance = std::sqrt(dx * dx + dy * dy) * inv_half_diagonal;
+            rates.push_back(distance <= inner ? ShadingRate::Rate1x1 : distance <= outer ? ShadingRate::Rate2x2 : ShadingRate::Rate4x4);
+        }
+        return rates;
+    }
+
+    void Renderer::SetShadowCascadeCount(int count) {
+        count = std::clamp(count, 1, ShadowMap::MAX_CASCADES);
+        if (count == m_shadowCascadeCount) return;
+        m_shadowCascadeCount = count;
+        m_shadowTargets.clear();
+    }
+
+    // ֻвֲͬĻƻͬһ洢ʱҪ (˳޹͸ʱа͸һύᷢ)
+    template<typename T>
+    inline void PushAttribute(std::vector<T>& attribute, size_t index, const T& value) {
+        if (attribute.size() < index) attribute.resize(index);
+        attribute.push_back(value);
+    }
+
+    void VaryingStore::Push(const Varyings& v, float inv_w, uint32_t varying_mask) {
+        if (varying_mask & VaryingLayout::Color) PushAttribute(color, count, v.color * inv_w);
+        if (varying_mask & VaryingLayout::WorldPos) PushAttribute(world_pos, count, v.world_pos * inv_w);
+        if (varying_mask & VaryingLayout::WorldNormal) PushAttribute(world_normal, count, v.world_normal * inv_w);
+        if (varying_mask & VaryingLayout::UV) PushAttribute(uv, count, v.uv * inv_w);
+        if (varying_mask & VaryingLayout::TangentSpaceLightDir) PushAttribute(tangent_space_light_dir, count, v.tangent_space_light_dir * inv_w);
+        if (varying_mask & VaryingLayout::TangentSpaceViewDir) PushAttribute(tangent_space_view_dir, count, v.tangent_space_view_dir * inv_w);
+        if (varying_mask & VaryingLayout::WorldTangent) PushAttribute(world_tangent, count, v.world_tangent * inv_w);
+        count++;
+    }
+
+    // ͸Уֵ (ѾԤ 1/w)
+    template<typename T>
+    inline T InterpolateAttribute(const std::vector<T>& attribute, uint32_t i0, float w0, float w1, float w2, float w_interp) {
+        return (attribute[i0] * w0 + attribute[i0 + 1] * w1 + attribute[i0 + 2] * w2) * w_interp;
+    }
+
+    // ֲֵMask Ǳڳûõͬǵڴȡһ𱻱ȥ
+    template<uint32_t Mask>
+    inline void InterpolateVaryings(const VaryingStore& store, uint32_t i0, float w0, float w1, float w2, float w_interp, Varyings& out) {
+        if constexpr ((Mask & VaryingLayout::Color) != 0) out.color = InterpolateAttribute(store.color, i0, w0, w1, w2, w_interp);
+        if constexpr ((Mask & VaryingLayout::WorldPos) != 0) out.world_pos = InterpolateAttribute(store.world_pos, i0, w0, w1, w2, w_interp);
+        if constexpr ((Mask & VaryingLayout::WorldNormal) != 0) out.world_normal = InterpolateAttribute(store.world_normal, i0, w0, w1, w2, w_interp);
+        if constexpr ((Mask & VaryingLayout::UV) != 0) out.uv = InterpolateAttribute(store.uv, i0, w0, w1, w2, w_interp);
+        if constexpr ((Mask & VaryingLayout::TangentSpaceLightDir) != 0) out.tangent_space_light_dir = InterpolateAttribute(store.tangent_space_light_dir, i0, w0, w1, w2, w_interp);
+        if constexpr ((Mask & VaryingLayout::TangentSpaceViewDir) != 0) out.tangent_space_view_dir = InterpolateAttribute(store.tangent_space_view_dir, i0, w0, w1, w2, w_interp);
+        if constexpr ((Mask & VaryingLayout::WorldTangent) != 0) out.world_tangent = InterpolateAttribute(store.world_tangent, i0, w0, w1, w2, w_interp);
     }
 
-    void Renderer::RasterizeTriangle(const Varyings& v0, const Varyings& v1, const Varyings& v2, IShader& shader, const Tile& tile, const RenderState& renderState) {
-        // 1. ӿڱ任 (֮ǰͬVaryings)
-        int w = m_framebuffer->GetWidth();
-        int h = m_framebuffer->GetHeight();
-        Math::vec<3, float> p0_screen = { (v0.position_clip.x() + 1.0f) * 0.5f * w, (v0.position_clip.y() + 1.0f) * 0.5f * h, v0.position_clip.z() };
-        Math::vec<3, float> p1_screen = { (v1.position_clip.x() + 1.0f) * 0.5f * w, (v1.position_clip.y() + 1.0f) * 0.5f * h, v1.position_clip.z() };
-        Math::vec<3, float> p2_screen = { (v2.position_clip.x() + 1.0f) * 0.5f * w, (v2.position_clip.y() + 1.0f) * 0.5f * h, v2.position_clip.z() };
+    void Renderer::AddTriangleSetup(const Varyings& v0, const Varyings& v1, const Varyings& v2, uint32_t draw_id) {
+        // 1. ͸ӳ + ӿڱ任
+        int w = m_target->framebuffer->GetWidth();
+        int h = m_target->framebuffer->GetHeight();
+        const Varyings* vertices[3] = { &v0, &v1, &v2 };
+        float inv_w[3];
+        Math::Vector3f screen[3];
+        for (int i = 0; i < 3; ++i) {
+            const Math::Vector4f& clip = vertices[i]->position_clip;
+            inv_w[i] = 1.0f / clip.w();
+            screen[i] = { (clip.x() * inv_w[i] + 1.0f) * 0.5f * w, (clip.y() * inv_w[i] + 1.0f) * 0.5f * h, clip.z() * inv_w[i] };
+        }
+        const Math::Vector3f& pa = screen[0];
+        const Math::Vector3f& pb = screen[1];
+        const Math::Vector3f& pc = screen[2];
+
+        // 2. ֻһΣդֻʱ () Σ޳Ѿ NDC ° CullFaceEnable 
+        float total_area = (pb.x() - pa.x()) * (pc.y() - pa.y()) - (pc.x() - pa.x()) * (pb.y() - pa.y());
+        if (!(total_area > 0)) return;
+
+        // 3. ذΧУmax ǿϽ磬 Tile  maxX/maxY Լһ
+        int minX = std::max(0, (int)std::floor(std::min({ pa.x(), pb.x(), pc.x() })));
+        int minY = std::max(0, (int)std::floor(std::min({ pa.y(), pb.y(), pc.y() })));
+        int maxX = std::min(w, (int)std::ceil(std::max({ pa.x(), pb.x(), pc.x() })));
+        int maxY = std::min(h, (int)std::ceil(std::max({ pa.y(), pb.y(), pc.y() })));
+        if (minX >= maxX || minY >= maxY) return;
+
+        TriangleSetup setup;
+        setup.minX = (int16_t)minX;
+        setup.minY = (int16_t)minY;
+        setup.maxX = (int16_t)maxX;
+        setup.maxY = (int16_t)maxY;
 
-        // 2. Χ (֮ǰͬ)
-        int minX = std::max(0, (int)std::floor(std::min({ p0_screen.x(), p1_screen.x(), p2_screen.x() })));
-        int minY = std::max(0, (int)std::floor(std::min({ p0_screen.y(), p1_screen.y(), p2_screen.y() })));
-        int maxX = std::min(w - 1, (int)std::ceil(std::max({ p0_screen.x(), p1_screen.x(), p2_screen.x() })));
-        int maxY = std::min(h - 1, (int)std::ceil(std::max({ p0_screen.y(), p1_screen.y(), p2_screen.y() })));
+        // 4. ߺ E0 (b->c)E1 (c->a)  b0b1ǶԺ
+        float inv_area = 1.0f / total_area;
+        float ox = (float)minX + 0.5f;
+        float oy = (float)minY + 0.5f;
+        setup.b0_dx = (pb.y() - pc.y()) * inv_area;
+        setup.b0_dy = (pc.x() - pb.x()) * inv_area;
+        setup.b0_c = ((pb.x() - ox) * (pc.y() - oy) - (pc.x() - ox) * (pb.y() - oy)) * inv_area;
+        setup.b1_dx = (pc.y() - pa.y()) * inv_area;
+        setup.b1_dy = (pa.x() - pc.x()) * inv_area;
+        setup.b1_c = ((pc.x() - ox) * (pa.y() - oy) - (pa.x() - ox) * (pc.y() - oy)) * inv_area;
 
-        // 󽻼
-        int clamped_minX = std::max(minX, tile.minX);
-        int clamped_minY = std::max(minY, tile.minY);
-        int clamped_maxX = std::min(maxX, tile.maxX);
-        int clamped_maxY = std::min(maxY, tile.maxY);
+        const DrawData& draw = m_draws[draw_id];
+        float depth_bias = 0.0f;
+        if (draw.renderState.depthBiasSlope != 0.0f || draw.renderState.depthBiasConstant != 0.0f) {
+            // ȹбʣƽֱӵõ
+            float dz_dx = pa.z() * setup.b0_dx + pb.z() * setup.b1_dx - pc.z() * (setup.b0_dx + setup.b1_dx);
+            float dz_dy = pa.z() * setup.b0_dy + pb.z() * setup.b1_dy - pc.z() * (setup.b0_dy + setup.b1_dy);
+            depth_bias = draw.renderState.depthBiasSlope * std::max(std::abs(dz_dx), std::abs(dz_dy)) + draw.renderState.depthBiasConstant;
+        }
+        for (int i = 0; i < 3; ++i) {
+            setup.z[i] = screen[i].z() + depth_bias;
+            setup.inv_w[i] = inv_w[i];
+        }
+        setup.drawId = draw_id;
+        setup.varyingOffset = static_cast<uint32_t>(m_varyings.Size());
 
-        // 3. Χڵÿ
+        const uint32_t varying_mask = draw.varyingMask;
+        m_varyings.Push(v0, inv_w[0], varying_mask);
+        m_varyings.Push(v1, inv_w[1], varying_mask);
+        m_varyings.Push(v2, inv_w[2], varying_mask);
+        m_triangleSetups.push_back(setup);
+    }
+
+    Renderer::PixelTarget Renderer::GetPixelTarget(size_t tile_index, const Tile& tile) {
+        if (m_target == &m_mainTarget && !m_multisampleActive) {
+            const ptrdiff_t stride = m_tileBuffer.GetTileSize();
+            return { m_tileBuffer.TileColor(tile_index), m_tileBuffer.TileDepth(tile_index), -(ptrdiff_t)tile.minY * stride - tile.minX, stride };
+        }
+        Framebuffer& framebuffer = *m_target->framebuffer;
+        const ptrdiff_t width = framebuffer.GetWidth();
+        return { framebuffer.GetColorData(), framebuffer.GetDepthData(), (ptrdiff_t)(framebuffer.GetHeight() - 1) * width, -width };
+    }
+
+    template<typename ShaderT, uint32_t Flags, uint32_t VaryingMask>
+    void Renderer::RasterizeTriangle(const TriangleSetup& setup, const Tile& tile, RenderStats& stats) {
+        constexpr bool dynamic_state = (Flags & DYNAMIC_RENDER_STATE) != 0;
+        constexpr bool blend = (Flags & static_cast<uint32_t>(RenderStateFlags::BlendEnable)) != 0;
+        constexpr bool depth_only = (Flags & static_cast<uint32_t>(RenderStateFlags::DepthOnly)) != 0;
+        constexpr bool gbuffer_write = (Flags & static_cast<uint32_t>(RenderStateFlags::GBufferWrite)) != 0;
+        constexpr bool oit = (Flags & static_cast<uint32_t>(RenderStateFlags::OITAccumulate)) != 0;
+        constexpr bool depth_test = (Flags & static_cast<uint32_t>(RenderStateFlags::DepthTestEnable)) != 0;
+        constexpr bool depth_write = (Flags & static_cast<uint32_t>(RenderStateFlags::DepthWriteEnable)) != 0;
+
+        const DrawData& draw = m_draws[setup.drawId];
+        // ShaderT  final ʱ FragmentShader ĵò
+        ShaderT& shader = static_cast<ShaderT&>(*draw.shader);
+        const RenderState& renderState = draw.renderState;
+        Framebuffer& framebuffer = *m_target->framebuffer; // ֻͳ Overdraw
+
+        // 1. Χ߿󽻼
+        int clamped_minX = std::max((int)setup.minX, tile.minX);
+        int clamped_minY = std::max((int)setup.minY, tile.minY);
+        int clamped_maxX = std::min((int)setup.maxX, tile.maxX);
+        int clamped_maxY = std::min((int)setup.maxY, tile.maxY);
+
+        [[maybe_unused]] const uint32_t i0 = setup.varyingOffset;
+        const size_t tile_index = (size_t)(tile.minY / TILE_SIZE) * m_target->columns + tile.minX / TILE_SIZE;
+        const PixelTarget pixels = GetPixelTarget(tile_index, tile);
+        // ƬԪɫͨҵӰ߿ľֲԴ (ֻ֡߿Դб)
+        [[maybe_unused]] const TileLightList* tile_lights = nullptr;
+        if constexpr (!depth_only && !gbuffer_write) {
+            if (m_localLightCount > 0 && m_target == &m_mainTarget) tile_lights = &m_tileLights[tile_index];
+        }
+        [[maybe_unused]] bool oit_written = false; // ߿дһΣ߿ıǰһƬԪд̼߳
+
+        // ɫʣʺ߿ɫͼȡϴֵһֻдȡд G-buffer Ӱͼء
+        // ɫʱĻ϶ rate x rate 黺ɫ (߿ rate ı鲻߿)
+        // ÿпһɫڵĿУդеб˻ȻʧЧ
+        int shading_rate = 1;
+        if constexpr (!depth_only && !gbuffer_write) {
+            if (m_target == &m_mainTarget) {
+                shading_rate = static_cast<int>(renderState.shadingRate);
+                if (!m_shadingRateImage.empty()) shading_rate = std::max(shading_rate, static_cast<int>(m_shadingRateImage[tile_index]));
+            }
+        }
+        int coarse_block_y[TILE_SIZE / 2];
+        Math::Vector4f coarse_color[TILE_SIZE / 2];
+        if (shading_rate > 1) std::fill_n(coarse_block_y, TILE_SIZE / shading_rate, -1);
+
+        // ͸Уֵֵֻɫ
+        auto interpolate = [&](float b0, float b1, float b2, Varyings& out) {
+            if constexpr (VaryingMask != VaryingLayout::None) {
+                float one_over_w_interp = b0 * setup.inv_w[0] + b1 * setup.inv_w[1] + b2 * setup.inv_w[2];
+                float w_interp = 1.0f / one_over_w_interp;
+                InterpolateVaryings<VaryingMask>(m_varyings, i0, b0, b1, b2, w_interp, out);
+            }
+        };
+        auto shade = [&](float b0, float b1, float b2) {
+            Varyings interpolated_varyings;
+            interpolate(b0, b1, b2, interpolated_varyings);
+            interpolated_varyings.tile_lights = tile_lights;
+            stats.fragmentsShaded++;
+            return shader.FragmentShader(interpolated_varyings, renderState);
+        };
+
+        // 2. Χڵÿ
         for (int y = clamped_minY; y < clamped_maxY; ++y) {
-            for (int x = clamped_minX; x <= clamped_maxX; ++x) {
-                // 㵱ǰĵ
-                Math::vec<2, float> p = { (float)x + 0.5f, (float)y + 0.5f };
-                Math::vec<2, float> pa = { p0_screen.x(), p0_screen.y() };
-                Math::vec<2, float> pb = { p1_screen.x(), p1_screen.y() };
-                Math::vec<2, float> pc = { p2_screen.x(), p2_screen.y() };
-
-                float total_area = (pb.x() - pa.x()) * (pc.y() - pa.y()) - (pc.x() - pa.x()) * (pb.y() - pa.y());
-                // 򵥵ı޳Է
-                if (total_area < 0) continue;
-
-                float w0 = ((pb.x() - p.x()) * (pc.y() - p.y()) - (pc.x() - p.x()) * (pb.y() - p.y())) / total_area;
-                float w1 = ((pc.x() - p.x()) * (pa.y() - p.y()) - (pa.x() - p.x()) * (pc.y() - p.y())) / total_area;
+            float row_b0 = setup.b0_c + setup.b0_dy * (float)(y - setup.minY);
+            float row_b1 = setup.b1_c + setup.b1_dy * (float)(y - setup.minY);
+            const ptrdiff_t row_index = pixels.origin + (ptrdiff_t)y * pixels.rowStep;
+            //  <  <=tile.maxX ұߵ߿飬߿߽һлᱻ߳ͬʱд
+            for (int x = clamped_minX; x < clamped_maxX; ++x) {
+                // ǰĵ
+                float w0 = row_b0 + setup.b0_dx * (float)(x - setup.minX);
+                float w1 = row_b1 + setup.b1_dx * (float)(x - setup.minX);
                 float w2 = 1.0f - w0 - w1;
 
                 // 궼[0,1]Χڣ
                 if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
-                    float one_over_w0 = 1.0f / v0.position_clip.w();
-                    float one_over_w1 = 1.0f / v1.position_clip.w();
-                    float one_over_w2 = 1.0f / v2.position_clip.w();
-                    float one_over_w_interp = w0 * one_over_w0 + w1 * one_over_w1 + w2 * one_over_w2;
-                    float w_interp = 1.0f / one_over_w_interp;
+                    // ֵ (NDC ĻռԵ)
+                    float z_interp = setup.z[0] * w0 + setup.z[1] * w1 + setup.z[2] * w2;
 
-                    // ֵ
-                    float z_interp = (p0_screen.z() * w0 + p1_screen.z() * w1 + p2_screen.z() * w2);
+                    // ǰȲԣڵƬԪٲֵɫ (ƬԪɫ޸ȣɫٲͬ)
+                    stats.fragmentsTested++;
+                    const size_t index = (size_t)(row_index + x);
+                    bool depth_passed = true;
+                    if constexpr (dynamic_state) depth_passed = !renderState.IsFlagEnabled(RenderStateFlags::DepthTestEnable) || z_interp < pixels.depth[index];
+                    else if constexpr (depth_test) depth_passed = z_interp < pixels.depth[index];
+                    if (!depth_passed) {
+                        stats.fragmentsDepthRejected++;
+                        continue;
+                    }
 
-                    // --- ޸ģֵ Varyings ---
-                    Varyings interpolated_varyings;
-                    //  color/w вֵ
-                    interpolated_varyings.color = ((v0.color * one_over_w0) * w0 +
-                        (v1.color * one_over_w1) * w1 +
-                        (v2.color * one_over_w2) * w2) * w_interp;
+                    // ֻд (Ӱͼ)ֵɫĿҲûɫ
+                    if constexpr (depth_only) {
+                        if constexpr (depth_write) pixels.depth[index] = z_interp;
+                        continue;
+                    }
+                    else if constexpr (dynamic_state) {
+                        if (renderState.IsFlagEnabled(RenderStateFlags::DepthOnly)) {
+                            if (renderState.IsFlagEnabled(RenderStateFlags::DepthWriteEnable)) pixels.depth[index] = z_interp;
+                            continue;
+                        }
+                    }
 
-                    interpolated_varyings.world_normal = ((v0.world_normal * one_over_w0) * w0 +
-                        (v1.world_normal * one_over_w1) * w1 +
-                        (v2.world_normal * one_over_w2) * w2) * w_interp;
+                    // ӳɫֻԣɫڹ Pass 
+                    if constexpr (gbuffer_write) {
+                        Varyings interpolated_varyings;
+                        interpolate(w0, w1, w2, interpolated_varyings);
+                        m_gbuffer.Write(x, y, shader.GBufferFragment(interpolated_varyings, renderState));
+                        stats.fragmentsShaded++;
+                        if constexpr (depth_write) pixels.depth[index] = z_interp;
+                        continue;
+                    }
+                    else if constexpr (dynamic_state) {
+                        if (renderState.IsFlagEnabled(RenderStateFlags::GBufferWrite)) {
+                            Varyings interpolated_varyings;
+                            interpolate(w0, w1, w2, interpolated_varyings);
+                            m_gbuffer.Write(x, y, shader.GBufferFragment(interpolated_varyings, renderState));
+                            stats.fragmentsShaded++;
+                            if (renderState.IsFlagEnabled(RenderStateFlags::DepthWriteEnable)) pixels.depth[index] = z_interp;
+                            continue;
+                        }
+                    }
 
-                    interpolated_varyings.uv = ((v0.uv * one_over_w0) * w0 +
-                        (v1.uv * one_over_w1) * w1 +
-						(v2.uv * one_over_w2) * w2) * w_interp;
+                    // 3. ƬԪɫɫʱһͨȲԵڿɫظý
+                    // (ʱɫԲ嵽֮)
+                    Math::Vector4f final_color;
+                    if (shading_rate == 1) {
+                        final_color = shade(w0, w1, w2);
+                    }
+                    else {
+                        const int slot = (x - tile.minX) / shading_rate;
+                        const int block_y = y / shading_rate;
+                        if (coarse_block_y[slot] == block_y) {
+                            final_color = coarse_color[slot];
+                        }
+                        else {
+                            const float half_block = 0.5f * (float)(shading_rate - 1);
+                            const float dx = (float)(x - x % shading_rate) + half_block - (float)x;
+                            const float dy = (float)(y - y % shading_rate) + half_block - (float)y;
+                            float c0 = w0 + setup.b0_dx * dx + setup.b0_dy * dy;
+                            float c1 = w1 + setup.b1_dx * dx + setup.b1_dy * dy;
+                            float c2 = 1.0f - c0 - c1;
+                            if (!(c0 >= 0 && c1 >= 0 && c2 >= 0)) {
+                                c0 = w0;
+                                c1 = w1;
+                                c2 = w2;
+                            }
+                            final_color = shade(c0, c1, c2);
+                            coarse_block_y[slot] = block_y;
+                            coarse_color[slot] = final_color;
+                        }
+                    }
 
-                    interpolated_varyings.tangent_space_light_dir = ((v0.tangent_space_light_dir * one_over_w0) * w0 +
-                        (v1.tangent_space_light_dir * one_over_w1) * w1 +
-						(v2.tangent_space_light_dir * one_over_w2) * w2) * w_interp;
-                    interpolated_varyings.tangent_space_view_dir = ((v0.tangent_space_view_dir * one_over_w0) * w0 +
-						(v1.tangent_space_view_dir * one_over_w1) * w1 + (v2.tangent_space_view_dir * one_over_w2) * w2) * w_interp;
+                    // ˳޹͸Ȩۼӣϳа͸廭֮ (ľǲüռ w)
+                    if constexpr (oit) {
+                        float view_depth = 1.0f / (w0 * setup.inv_w[0] + w1 * setup.inv_w[1] + w2 * setup.inv_w[2]);
+                        m_oitBuffer.Accumulate(x, y, final_color, view_depth);
+                        stats.fragmentsBlended++;
+                        oit_written = true;
+                        continue;
+                    }
+                    else if constexpr (dynamic_state) {
+                        if (renderState.IsFlagEnabled(RenderStateFlags::OITAccumulate)) {
+                            float view_depth = 1.0f / (w0 * setup.inv_w[0] + w1 * setup.inv_w[1] + w2 * setup.inv_w[2]);
+                            m_oitBuffer.Accumulate(x, y, final_color, view_depth);
+                            stats.fragmentsBlended++;
+                            oit_written = true;
+                            continue;
+                        }
+                    }
 
-                    // 5. ƬԪɫ
-                    Math::Vector4f final_color = shader.FragmentShader(interpolated_varyings, renderState);
+                    // 4. дɫ (ȲѾɫ֮ǰ)
+                    framebuffer.CountOverdraw(x, y);
+                    if constexpr (dynamic_state) {
+                        if (renderState.IsFlagEnabled(RenderStateFlags::BlendEnable)) {
+                            stats.fragmentsBlended++;
+                            pixels.color[index] = blend_color(final_color, pixels.color[index]);
+                        }
+                        else {
+                            pixels.color[index] = to_color(final_color);
+                        }
+                        if (renderState.IsFlagEnabled(RenderStateFlags::DepthWriteEnable)) pixels.depth[index] = z_interp;
+                    }
+                    else {
+                        if constexpr (blend) stats.fragmentsBlended++;
+                        write_fragment<Flags>(pixels.color, pixels.depth, index, z_interp, final_color);
+                    }
+                }
+            }
+        }
+        if constexpr (oit || dynamic_state) {
+            if (oit_written) m_oitTileUsed[tile_index] = 1;
+        }
+    }
+
+    //  RasterizeTriangle ֻڸǡȲԺд룺ÿؼ 4 㣬
+    // в㱻ǲͨȲʱƬԪɫһΣɫдЩϣд
+    template<typename ShaderT, uint32_t Flags, uint32_t VaryingMask>
+    void Renderer::RasterizeTriangleMultisample(const TriangleSetup& setup, const Tile& tile, RenderStats& stats) {
+        constexpr int sample_count = MultisampleBuffer::SAMPLE_COUNT;
+        constexpr uint32_t full_coverage = (1u << sample_count) - 1;
+        constexpr bool dynamic_state = (Flags & DYNAMIC_RENDER_STATE) != 0;
+
+        const DrawData& draw = m_draws[setup.drawId];
+        ShaderT& shader = static_cast<ShaderT&>(*draw.shader);
+        const RenderState& renderState = draw.renderState;
+        Framebuffer& framebuffer = *m_target->framebuffer; // ֻͳ Overdraw
+
+        // Ⱦ״̬ÿζһΣػ汾Щǳõǵķ֧ڱھͱȥ
+        auto enabled = [&](RenderStateFlags flag) {
+            if constexpr (dynamic_state) return renderState.IsFlagEnabled(flag);
+            else return (Flags & static_cast<uint32_t>(flag)) != 0;
+        };
+        const bool depth_test = enabled(RenderStateFlags::DepthTestEnable);
+        const bool depth_write = enabled(RenderStateFlags::DepthWriteEnable);
+        const bool blend = enabled(RenderStateFlags::BlendEnable);
+        const bool oit = enabled(RenderStateFlags::OITAccumulate);
+
+        int clamped_minX = std::max((int)setup.minX, tile.minX);
+        int clamped_minY = std::max((int)setup.minY, tile.minY);
+        int clamped_maxX = std::min((int)setup.maxX, tile.maxX);
+        int clamped_maxY = std::min((int)setup.maxY, tile.maxY);
 
-                    // 6. д֡ (Ȳ)
-                    m_framebuffer->SetPixel(x, y, z_interp, final_color, renderState);
+        [[maybe_unused]] const uint32_t i0 = setup.varyingOffset;
+        const size_t tile_index = (size_t)(tile.minY / TILE_SIZE) * m_target->columns + tile.minX / TILE_SIZE;
+        const TileLightList* tile_lights = m_localLightCount > 0 ? &m_tileLights[tile_index] : nullptr;
+        float* tile_depth = m_multisampleBuffer.TileDepth(tile_index);
+        uint32_t* tile_color = m_multisampleBuffer.TileColor(tile_index);
+        bool oit_written = false;
+
+        // ĵζһ
+        float b0_offset[sample_count], b1_offset[sample_count], z_offset[sample_count];
+        for (int s = 0; s < sample_count; ++s) {
+            const float ox = MultisampleBuffer::SAMPLE_OFFSETS[s][0];
+            const float oy = MultisampleBuffer::SAMPLE_OFFSETS[s][1];
+            b0_offset[s] = setup.b0_dx * ox + setup.b0_dy * oy;
+            b1_offset[s] = setup.b1_dx * ox + setup.b1_dy * oy;
+            // z = z2 + (z0 - z2) * b0 + (z1 - z2) * b1
+            z_offset[s] = (setup.z[0] - setup.z[2]) * b0_offset[s] + (setup.z[1] - setup.z[2]) * b1_offset[s];
+        }
+
+        for (int y = clamped_minY; y < clamped_maxY; ++y) {
+            float row_b0 = setup.b0_c + setup.b0_dy * (float)(y - setup.minY);
+            float row_b1 = setup.b1_c + setup.b1_dy * (float)(y - setup.minY);
+            for (int x = clamped_minX; x < clamped_maxX; ++x) {
+                // ĵ
+                float w0 = row_b0 + setup.b0_dx * (float)(x - setup.minX);
+                float w1 = row_b1 + setup.b1_dx * (float)(x - setup.minX);
+
+                // 1. ǣÿһλ
+                uint32_t coverage = 0;
+                for (int s = 0; s < sample_count; ++s) {
+                    float s0 = w0 + b0_offset[s];
+                    float s1 = w1 + b1_offset[s];
+                    if (s0 >= 0 && s1 >= 0 && 1.0f - s0 - s1 >= 0) coverage |= 1u << s;
+                }
+                if (coverage == 0) continue;
+
+                // 2. Ȳ (Ȼɫ֮ǰ)
+                const float z_center = setup.z[2] + (setup.z[0] - setup.z[2]) * w0 + (setup.z[1] - setup.z[2]) * w1;
+                const size_t p = m_multisampleBuffer.PixelOffset(x - tile.minX, y - tile.minY);
+                float* depth = tile_depth + p;
+                uint32_t* color = tile_color + p;
+                stats.fragmentsTested++;
+                uint32_t passed = coverage;
+                if (depth_test) {
+                    passed = 0;
+                    for (int s = 0; s < sample_count; ++s) {
+                        if ((coverage >> s) & 1u && z_center + z_offset[s] < depth[s]) passed |= 1u << s;
+                    }
+                    if (passed == 0) {
+                        stats.fragmentsDepthRejected++;
+                        continue;
+                    }
+                }
+
+                // 3. ɫλãʱõһǵĲ㣬Բ嵽֮ (Ĳ)
+                float w2 = 1.0f - w0 - w1;
+                if (coverage != full_coverage && !(w0 >= 0 && w1 >= 0 && w2 >= 0)) {
+                    int s = 0;
+                    while (!((coverage >> s) & 1u)) ++s;
+                    w0 += b0_offset[s];
+                    w1 += b1_offset[s];
+                    w2 = 1.0f - w0 - w1;
+                }
+
+                Varyings interpolated_varyings;
+                if constexpr (VaryingMask != VaryingLayout::None) {
+                    float one_over_w_interp = w0 * setup.inv_w[0] + w1 * setup.inv_w[1] + w2 * setup.inv_w[2];
+                    float w_interp = 1.0f / one_over_w_interp;
+                    InterpolateVaryings<VaryingMask>(m_varyings, i0, w0, w1, w2, w_interp, interpolated_varyings);
+                }
+                interpolated_varyings.tile_lights = tile_lights;
+                Math::Vector4f final_color = shader.FragmentShader(interpolated_varyings, renderState);
+                stats.fragmentsShaded++;
+                framebuffer.CountOverdraw(x, y);
+
+                // ˳޹͸ɫۼӣ͸ʰɼĲֱ۳
+                if (oit) {
+                    float view_depth = 1.0f / (w0 * setup.inv_w[0] + w1 * setup.inv_w[1] + w2 * setup.inv_w[2]);
+                    m_oitBuffer.Accumulate(x, y, final_color, view_depth, passed);
+                    stats.fragmentsBlended++;
+                    oit_written = true;
+                    continue;
+                }
+
+                // 4. дͨԵĲ㡣ʱڲɫͨͬϽֱӸ
+                const uint32_t packed = blend ? 0u : to_color(final_color);
+                uint32_t last_dst = 0, last_blended = 0;
+                bool has_last = false;
+                if (blend) stats.fragmentsBlended++;
+                for (int s = 0; s < sample_count; ++s) {
+                    if (!((passed >> s) & 1u)) continue;
+                    if (depth_write) depth[s] = z_center + z_offset[s];
+                    if (blend) {
+                        if (!has_last || color[s] != last_dst) {
+                            last_dst = color[s];
+                            last_blended = blend_color(final_color, last_dst);
+                            has_last = true;
+                        }
+                        color[s] = last_blended;
+                    }
+                    else {
+                        color[s] = packed;
+                    }
                 }
             }
         }
+        if (oit_written) m_oitTileUsed[tile_index] = 1;
     }
 
-    void Renderer::ProcessRenderQueue(const std::vector<RenderCommand>& queue, const Scene::Scene& scene, bool is_transparent_pass)
-    {
-        m_renderPackets.clear(); // һ֡Ⱦ
+    template<typename ShaderT, uint32_t State, bool Multisample>
+    RasterizeTriangleFn Renderer::ShaderRasterizer() {
+        // д G-buffer ʱֵһ
+        constexpr uint32_t varying_mask = (State & static_cast<uint32_t>(RenderStateFlags::GBufferWrite)) ?
+            ShaderT::GBUFFER_VARYING_MASK : ShaderT::VARYING_MASK;
+        // ֻдȺд G-buffer ĻƲززЩһ
+        constexpr uint32_t single_sample_only = static_cast<uint32_t>(RenderStateFlags::DepthOnly) |
+            static_cast<uint32_t>(RenderStateFlags::GBufferWrite);
+        if constexpr (Multisample && (State & single_sample_only) == 0) {
+            return &Renderer::RasterizeTriangleMultisample<ShaderT, State, varying_mask>;
+        }
+        else {
+            return &Renderer::RasterizeTriangle<ShaderT, State, varying_mask>;
+        }
+    }
+
+    template<typename ShaderT, bool Multisample, size_t... States>
+    std::array<RasterizeTriangleFn, sizeof...(States)> Renderer::MakeShaderRasterizerTable(std::index_sequence<States...>) {
+        // Ӱѭλ ( CullFaceEnable) ȥӦıͬһʵ
+        return { ShaderRasterizer<ShaderT, static_cast<uint32_t>(States) & RASTER_STATE_MASK, Multisample>()... };
+    }
+
+    template<bool Multisample, size_t... Masks>
+    std::array<RasterizeTriangleFn, sizeof...(Masks)> Renderer::MakeGenericRasterizerTable(std::index_sequence<Masks...>) {
+        if constexpr (Multisample) {
+            return { &Renderer::RasterizeTriangleMultisample<IShader, DYNAMIC_RENDER_STATE, static_cast<uint32_t>(Masks)>... };
+        }
+        else {
+            return { &Renderer::RasterizeTriangle<IShader, DYNAMIC_RENDER_STATE, static_cast<uint32_t>(Masks)>... };
+        }
+    }
 
+    RasterizeTriangleFn Renderer::SelectRasterizer(const IShader& shader, const RenderState& renderState, uint32_t varying_mask, bool multisample) {
+        static const auto blinn_phong = MakeShaderRasterizerTable<BlinnPhongShader, false>(std::make_index_sequence<RASTER_STATE_COUNT>());
+        static const auto unlit = MakeShaderRasterizerTable<UnlitShader, false>(std::make_index_sequence<RASTER_STATE_COUNT>());
+        static const auto shadow_map = MakeShaderRasterizerTable<ShadowMapShader, false>(std::make_index_sequence<RASTER_STATE_COUNT>());
+        static const auto generic = MakeGenericRasterizerTable<false>(std::make_index_sequence<VaryingLayout::Count>());
+        // زֻ֡壬ӰͼɫҪ
+        static const auto blinn_phong_ms = MakeShaderRasterizerTable<BlinnPhongShader, true>(std::make_index_sequence<RASTER_STATE_COUNT>());
+        static const auto unlit_ms = MakeShaderRasterizerTable<UnlitShader, true>(std::make_index_sequence<RASTER_STATE_COUNT>());
+        static const auto generic_ms = MakeGenericRasterizerTable<true>(std::make_index_sequence<VaryingLayout::Count>());
+
+        const uint32_t state = renderState.flags & RASTER_STATE_MASK;
+        if (dynamic_cast<const BlinnPhongShader*>(&shader)) return (multisample ? blinn_phong_ms : blinn_phong)[state];
+        if (dynamic_cast<const UnlitShader*>(&shader)) return (multisample ? unlit_ms : unlit)[state];
+        if (dynamic_cast<const ShadowMapShader*>(&shader)) return shadow_map[state];
+        return (multisample ? generic_ms : generic)[varying_mask & VaryingLayout::All];
+    }
+
+    void Renderer::ProcessRenderQueue(const std::vector<RenderCommand>& queue, const Scene::Scene& scene, bool is_transparent_pass,
+        QueueFilter filter)
+    {
         const auto& camera = scene.GetCamera();
         const Math::Matrix4f& viewMatrix = camera.GetViewMatrix();
-        const Math::Matrix4f& projectionMatrix = camera.GetProjectionMatrix();
+        const Math::Matrix4f& projectionMatrix = m_frameProjection;
+        const bool oit = is_transparent_pass && m_orderIndependentTransparency;
 
         for (const auto& command : queue)
         {
@@ -131,199 +634,987 @@ namespace Morpheus::Renderer {
 
             auto& shader = *object.material->shader;
             const auto& material = *object.material;
+            if (filter != QueueFilter::All && shader.SupportsGBuffer() != (filter == QueueFilter::GBufferOnly)) continue;
 
-            // 1.  Shader Uniforms
+            // 1. ֡ڷ׼λƵ Uniforms (֡ЧRender ʼʱͳһ)
             const Math::Matrix4f& modelMatrix = object.transform;
-            shader.uniforms["u_model"] = modelMatrix;
-            shader.uniforms["u_view"] = viewMatrix;
-            shader.uniforms["u_projection"] = projectionMatrix;
-            shader.uniforms["u_mvp"] = projectionMatrix * viewMatrix * modelMatrix;
-
-            // ---  Uniforms ---
+            const auto& lights = scene.GetDirectionalLights();
+            DrawUniforms* uniforms = m_frameArena.New<DrawUniforms>();
+            uniforms->model = modelMatrix;
+            uniforms->view = viewMatrix;
+            uniforms->projection = projectionMatrix;
+            uniforms->mvp = projectionMatrix * viewMatrix * modelMatrix;
             // 㲢ݷ߾
-            shader.uniforms["u_normal_matrix"] = modelMatrix.inverse().transpose();
+            uniforms->normal_matrix = modelMatrix.inverse().transpose();
 
             // ݲʲ
-            shader.uniforms["u_albedo_factor"] = material.albedo_factor;
-            shader.uniforms["u_albedo_texture"] = material.albedo_texture;
-            shader.uniforms["u_normal_texture"] = material.normal_texture;
-            shader.uniforms["u_shininess"] = material.specular_shininess;
-			shader.uniforms["u_alpha_factor"] = material.alpha_factor;
-            // ݳϢ
-            shader.uniforms["u_camera_pos"] = camera.GetPosition();
-            shader.uniforms["u_lights"] = scene.GetDirectionalLights(); // ֱӴvector
-
-            const auto& mesh = *object.mesh;
+            uniforms->albedo_factor = material.albedo_factor;
+            uniforms->albedo_texture = material.albedo_texture.get();
+            uniforms->normal_texture = material.normal_texture.get();
+            uniforms->shininess = material.specular_shininess;
+            uniforms->alpha_factor = material.alpha_factor;
+            // ݳϢ (ƹֱָ򳡾飬Ⱦڼ䳡޸)
+            uniforms->camera_pos = camera.GetPosition();
+            uniforms->lights = lights.data();
+            uniforms->light_count = lights.size();
+            uniforms->shadow_maps = m_shadowMaps;
+            uniforms->local_lights = m_localLights;
+
+            // --- ιõ RenderState ---
+            RenderState packetRenderState;
+            packetRenderState.targetFramebuffer = m_framebuffer.get(); // ǰ֡
+            packetRenderState.uniforms = uniforms;
+            packetRenderState.shadingRate = material.shading_rate;
+
+            // ݲʺ pass  flags
+            bool is_transparent_material = false;
+            if (material.render_queue == RenderQueue::Transparent) {
+                is_transparent_material = true;
+            }
+
+            if (is_transparent_material) {
+                // ˳޹͸ʱۼӵ OIT 壬ֱɫ
+                packetRenderState.AddFlags(oit ? RenderStateFlags::OITAccumulate : RenderStateFlags::BlendEnable);
+                packetRenderState.RemoveFlags(RenderStateFlags::DepthWriteEnable); // ͸Ĭϲд
+                packetRenderState.AddFlags(RenderStateFlags::DepthTestEnable);
+            }
+            else {
+                packetRenderState.RemoveFlags(RenderStateFlags::BlendEnable);
+                packetRenderState.AddFlags(RenderStateFlags::DepthWriteEnable);
+                packetRenderState.AddFlags(RenderStateFlags::DepthTestEnable);
+            }
+            // ĬϿ޳
+            packetRenderState.AddFlags(RenderStateFlags::CullFaceEnable);
+            if (filter == QueueFilter::GBufferOnly) {
+                packetRenderState.AddFlags(RenderStateFlags::GBufferWrite);
+            }
+
+            if (oit) SubmitObject(*object.mesh, shader, packetRenderState);
+            else DrawObject(*object.mesh, shader, packetRenderState);
+        }
+        // ˳޹͸а͸һ䡢йդύ˳
+        if (oit) FlushTriangles();
+    }
+
+    void Renderer::DrawObject(const Mesh& mesh, IShader& shader, const RenderState& renderState) {
+        // ÿε͹դ֮Ϲդбֻеǰ
+        SubmitObject(mesh, shader, renderState);
+        FlushTriangles();
+    }
+
+    void Renderer::SubmitObject(const Mesh& mesh, IShader& shader, const RenderState& renderState) {
+        RenderStats& stats = *m_passStats;
+        const bool cull_back_faces = renderState.IsFlagEnabled(RenderStateFlags::CullFaceEnable);
+
+        const uint32_t draw_id = static_cast<uint32_t>(m_draws.size());
+        const uint32_t varying_mask = (renderState.IsFlagEnabled(RenderStateFlags::GBufferWrite) ?
+            shader.GetGBufferVaryingMask() : shader.GetVaryingMask()) & VaryingLayout::All;
+        // زֻ֡дɫĻ
+        const bool multisample = m_multisampleActive && m_target == &m_mainTarget &&
+            !renderState.IsFlagEnabled(RenderStateFlags::DepthOnly) && !renderState.IsFlagEnabled(RenderStateFlags::GBufferWrite);
+        m_draws.push_back({ &shader, renderState, varying_mask, SelectRasterizer(shader, renderState, varying_mask, multisample) });
+
+        // 2. ÿһζɫ (㲻ٰظɫ)
+        {
+            StageScope stage("VertexShading", m_timings.vertexShadingMs);
+            m_shadedVertices.resize(mesh.vertices.size());
+            for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+                m_shadedVertices[i] = shader.VertexShader(mesh.vertices[i], renderState);
+            }
+        }
+
+        {
+            StageScope clipping_stage("Clipping", m_timings.clippingMs);
+
+            // ޳ + ͸ӳ + ν
+            auto emit_triangle = [&](const Varyings& cv0, const Varyings& cv1, const Varyings& cv2) {
+                // ޳NDC µΪ (˳ʱ) βɽ¼
+                if (cull_back_faces) {
+                    Math::Vector2f n0 = { cv0.position_clip.x() / cv0.position_clip.w(), cv0.position_clip.y() / cv0.position_clip.w() };
+                    Math::Vector2f n1 = { cv1.position_clip.x() / cv1.position_clip.w(), cv1.position_clip.y() / cv1.position_clip.w() };
+                    Math::Vector2f n2 = { cv2.position_clip.x() / cv2.position_clip.w(), cv2.position_clip.y() / cv2.position_clip.w() };
+                    float signed_area = (n1.x() - n0.x()) * (n2.y() - n0.y()) - (n2.x() - n0.x()) * (n1.y() - n0.y());
+                    if (signed_area < 0) {
+                        stats.trianglesBackfaceCulled++;
+                        return;
+                    }
+                }
+                // ͸ӳνд SoA 洢
+                AddTriangleSetup(cv0, cv1, cv2, draw_id);
+            };
+
+            ClippedPolygon clipped; // üջϣÿη vector
             for (size_t i = 0; i < mesh.indices.size(); i += 3) {
-                // 2. ÿöɫ
-                Varyings v0_out = shader.VertexShader(mesh.vertices[mesh.indices[i]]);
-                Varyings v1_out = shader.VertexShader(mesh.vertices[mesh.indices[i + 1]]);
-                Varyings v2_out = shader.VertexShader(mesh.vertices[mesh.indices[i + 2]]);
-
-                // --- 2. ü ---
-                std::vector<Varyings> clipped_triangles = ClipTriangle(v0_out, v1_out, v2_out);
-
-                // 3. ü
-                for (size_t j = 0; j < clipped_triangles.size(); j += 3) {
-                    Varyings& cv0 = clipped_triangles[j];
-                    Varyings& cv1 = clipped_triangles[j + 1];
-                    Varyings& cv2 = clipped_triangles[j + 2];
-
-                    // 4. ÿüν͸ӳ
-                    cv0.position_clip = cv0.position_clip * (1.0f / cv0.position_clip.w());
-                    cv1.position_clip = cv1.position_clip * (1.0f / cv1.position_clip.w());
-                    cv2.position_clip = cv2.position_clip * (1.0f / cv2.position_clip.w());
-
-                    // --- 洢Ⱦ ---
-                    // ǽõĶָǰ shader ָһ
-                    // ---  RenderPacket  RenderState ---
-                    RenderPacket packet;
-                    packet.v0 = cv0;
-                    packet.v1 = cv1;
-                    packet.v2 = cv2;
-                    packet.shader = &shader; // 洢ָ shader ָ
-
-                    // ---  RenderState for this Packet ---
-                    RenderState packetRenderState;
-                    packetRenderState.targetFramebuffer = m_framebuffer.get(); // ǰ֡
-
-                    // ݲʺ pass  flags
-                    bool is_transparent_material = false;
-                    if (material.render_queue == RenderQueue::Transparent) {
-                        is_transparent_material = true;
+                const Varyings& v0_out = m_shadedVertices[mesh.indices[i]];
+                const Varyings& v1_out = m_shadedVertices[mesh.indices[i + 1]];
+                const Varyings& v2_out = m_shadedVertices[mesh.indices[i + 2]];
+                stats.trianglesSubmitted++;
+
+                // --- 3. ü ---
+                // 㶼׶ʱüıΣֱʹԭĶ (·Ҳÿ)
+                if (IsInsideClipVolume(v0_out) && IsInsideClipVolume(v1_out) && IsInsideClipVolume(v2_out)) {
+                    emit_triangle(v0_out, v1_out, v2_out);
+                    continue;
+                }
+
+                ClipTriangle(v0_out, v1_out, v2_out, clipped);
+                if (clipped.count == 0) {
+                    stats.trianglesOutsideFrustum++;
+                    continue;
+                }
+                stats.trianglesClipped++;
+
+                // 4. ü͹ΰβ
+                for (int j = 1; j + 1 < clipped.count; ++j) {
+                    emit_triangle(clipped.vertices[0], clipped.vertices[j], clipped.vertices[j + 1]);
+                }
+            }
+        }
+    }
+
+    void Renderer::FlushTriangles() {
+        if (!m_triangleSetups.empty()) {
+            {
+                StageScope stage("Binning", m_timings.binningMs);
+                DistributePacketsToTiles();
+            }
+
+            // --- ޸ RenderTiles֪ǰʲô Pass ---
+            StageScope stage("Raster", m_timings.rasterMs);
+            RenderTiles();
+        }
+        m_triangleSetups.clear();
+        m_varyings.Clear();
+    }
+
+    // --- Ӱ Pass ---
+    // Ӱ׶ӽƽ浽Ӱ밴/ȻϵķʽгɼΣÿһΧס
+    // ÿƽйΪÿȾһͶӰӰͼΧİ뾶ֻȡ׶ڹԴռ䰴ض룬
+    // ƶʱӰԵ˸ʱȫ䣬̬ͶӰһֱá
+    // Ӱͼ֡һֳ߿飬ͬһ׷Ͷ̹߳դդѡ DepthOnly ػ汾
+    void Renderer::RenderShadowMaps(const Scene::Scene& scene, const std::vector<RenderCommand>& casters) {
+        m_shadowMaps = nullptr;
+        const auto& lights = scene.GetDirectionalLights();
+        if (!m_shadowsEnabled || lights.empty() || casters.empty()) return;
+
+        StageScope shadow_stage("Shadows", m_timings.shadowMs);
+
+        // 1. ͶռΧ (ģͰΧе 8 Ǳ任ռ)Լо̬Ͷǩ
+        // ǩǸϣ֮ͣ˳޹ (͸аľһ˳ͻ)
+        m_shadowCasters.clear();
+        uint64_t static_signature = 0;
+        size_t static_caster_count = 0;
+        for (const auto& command : casters) {
+            const auto& object = *command.object;
+            if (!object.mesh) continue;
+
+            Math::Vector3f world_min = { FLT_MAX, FLT_MAX, FLT_MAX };
+            Math::Vector3f world_max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            const Math::Vector3f& bmin = object.mesh->boundsMin;
+            const Math::Vector3f& bmax = object.mesh->boundsMax;
+            for (int corner = 0; corner < 8; ++corner) {
+                Math::Vector4f p = { (corner & 1) ? bmax.x() : bmin.x(), (corner & 2) ? bmax.y() : bmin.y(), (corner & 4) ? bmax.z() : bmin.z(), 1.0f };
+                Math::Vector3f world = (object.transform * p).xyz();
+                for (int i = 0; i < 3; ++i) {
+                    world_min[i] = std::min(world_min[i], world[i]);
+                    world_max[i] = std::max(world_max[i], world[i]);
+                }
+            }
+            m_shadowCasters.push_back({ &object, (world_min + world_max) * 0.5f, (world_max - world_min).length() * 0.5f, object.isStatic });
+
+            if (object.isStatic) {
+                // FNV-1a (ػỻµ) ͱ任
+                uint64_t hash = 14695981039346656037ull;
+                auto hash_bytes = [&hash](const void* data, size_t size) {
+                    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                    for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * 1099511628211ull;
+                };
+                const Mesh* mesh = object.mesh.get();
+                hash_bytes(&mesh, sizeof(mesh));
+                hash_bytes(object.transform.m, sizeof(object.transform.m));
+                static_signature += hash;
+                static_caster_count++;
+            }
+        }
+        if (m_shadowCasters.empty()) return;
+        static_signature += static_caster_count;
+
+        // 2. Ļ֣Լÿ׶СΧ (ռϣ뾶޹)
+        const auto& camera = scene.GetCamera();
+        const int cascade_count = m_shadowCascadeCount;
+        const float near_plane = camera.GetNear();
+        const float shadow_far = std::max(near_plane * 2.0f, std::min(camera.GetFar(), m_shadowDistance));
+        const float tan_half_fov = std::tan(camera.GetFovY() * 0.5f);
+        // ׶Խ֮ȵƽ
+        const float corner_slope_sq = tan_half_fov * tan_half_fov * (1.0f + camera.GetAspect() * camera.GetAspect());
+        const Math::Matrix4f inverse_view = camera.GetViewMatrix().inverse();
+
+        Math::Vector3f cascade_centers[ShadowMap::MAX_CASCADES];
+        float cascade_radii[ShadowMap::MAX_CASCADES];
+        float split_near = near_plane;
+        for (int c = 0; c < cascade_count; ++c) {
+            float t = (float)(c + 1) / (float)cascade_count;
+            float log_split = near_plane * std::pow(shadow_far / near_plane, t);
+            float uniform_split = near_plane + (shadow_far - near_plane) * t;
+            float split_far = SHADOW_CASCADE_SPLIT_LAMBDA * log_split + (1.0f - SHADOW_CASCADE_SPLIT_LAMBDA) * uniform_split;
+
+            // ĵĽǺԶĽǾȵλãԶʱȡԶ
+            float center_depth = std::min(split_far, (split_near + split_far) * (1.0f + corner_slope_sq) * 0.5f);
+            float far_offset = split_far - center_depth;
+            cascade_radii[c] = std::sqrt(split_far * split_far * corner_slope_sq + far_offset * far_offset);
+            cascade_centers[c] = (inverse_view * Math::Vector4f{ 0.0f, 0.0f, -center_depth, 1.0f }).xyz();
+            split_near = split_far;
+        }
+
+        // 3. ΪÿԴÿ׼Ӱͼ
+        const size_t target_count = lights.size() * cascade_count;
+        if (m_shadowTargets.size() < target_count) m_shadowTargets.resize(target_count);
+        ShadowMap* shadow_maps = m_frameArena.NewArray<ShadowMap>(lights.size());
+
+        m_passStats = &m_shadowStats;
+        for (size_t l = 0; l < lights.size(); ++l) {
+            // Դռ䣺ԭԭ㣬-Z ָǰķ
+            const Math::Vector3f dir = Math::normalize(lights[l].direction);
+            const Math::Vector3f up = std::abs(dir.y()) > 0.99f ? Math::Vector3f{ 1.0f, 0.0f, 0.0f } : Math::Vector3f{ 0.0f, 1.0f, 0.0f };
+            const Math::Matrix4f light_view = Math::Matrix4f::LookAt({ 0.0f, 0.0f, 0.0f }, dir, up);
+
+            // ԴͶ (Դռ z )ƽҪǰ
+            float casters_top = -FLT_MAX;
+            for (const ShadowCaster& caster : m_shadowCasters) {
+                float z = (light_view * Math::Vector4f{ caster.center.x(), caster.center.y(), caster.center.z(), 1.0f }).z();
+                casters_top = std::max(casters_top, z + caster.radius);
+            }
+
+            shadow_maps[l].cascadeCount = cascade_count;
+            for (int c = 0; c < cascade_count; ++c) {
+                // ηΧȰΧԴİض֮Ȼס׶
+                const float extent = cascade_radii[c] * (1.0f + 4.0f / (float)m_shadowMapSize);
+                const float texel = 2.0f * extent / (float)m_shadowMapSize;
+                Math::Vector3f center = (light_view * Math::Vector4f{ cascade_centers[c].x(), cascade_centers[c].y(), cascade_centers[c].z(), 1.0f }).xyz();
+                for (int i = 0; i < 3; ++i) center[i] = std::floor(center[i] / texel) * texel;
+
+                // ƽ水 extent ȡ̬ͶСΧƶı󣬾̬治ʧЧ
+                float top = std::max(std::ceil(casters_top / extent) * extent, center.z() + extent);
+                const Math::Vector3f cascade_min = { center.x() - extent, center.y() - extent, center.z() - extent };
+                const Math::Vector3f cascade_max = { center.x() + extent, center.y() + extent, top };
+                const Math::Matrix4f light_projection = Math::Matrix4f::Orthographic(
+                    cascade_min.x(), cascade_max.x(), cascade_min.y(), cascade_max.y(), -cascade_max.z(), -cascade_min.z());
+                const Math::Matrix4f light_view_projection = light_projection * light_view;
+
+                // ޳ͶԴռİΧ뼶İΧвཻͲ
+                m_cascadeCasters.clear();
+                size_t dynamic_count = 0;
+                for (const ShadowCaster& caster : m_shadowCasters) {
+                    Math::Vector3f p = (light_view * Math::Vector4f{ caster.center.x(), caster.center.y(), caster.center.z(), 1.0f }).xyz();
+                    bool outside = false;
+                    for (int i = 0; i < 3; ++i) {
+                        if (p[i] + caster.radius < cascade_min[i] || p[i] - caster.radius > cascade_max[i]) outside = true;
                     }
+                    if (outside) continue;
+                    m_cascadeCasters.push_back(&caster);
+                    if (!caster.isStatic) dynamic_count++;
+                }
 
-                    if (is_transparent_material) {
-                        packetRenderState.AddFlags(RenderStateFlags::BlendEnable);
-                        packetRenderState.RemoveFlags(RenderStateFlags::DepthWriteEnable); // ͸Ĭϲд
-                        packetRenderState.AddFlags(RenderStateFlags::DepthTestEnable);
+                ShadowCascadeTarget& cascade_target = m_shadowTargets[l * cascade_count + c];
+                if (!cascade_target.depth) {
+                    cascade_target.depth = std::make_unique<Framebuffer>(m_shadowMapSize, m_shadowMapSize, true);
+                    cascade_target.target.Init(cascade_target.depth.get());
+                    cascade_target.depthCleared = false;
+                }
+
+                // ̬Ͷ;̬嶼ûʱϴλĽ
+                if (static_caster_count > 0) {
+                    if (!cascade_target.staticDepth) {
+                        cascade_target.staticDepth = std::make_unique<Framebuffer>(m_shadowMapSize, m_shadowMapSize, true);
+                        cascade_target.staticTarget.Init(cascade_target.staticDepth.get());
+                        cascade_target.staticValid = false;
+                    }
+                    const bool cache_valid = cascade_target.staticValid && cascade_target.staticSignature == static_signature &&
+                        std::memcmp(cascade_target.staticViewProjection.m, light_view_projection.m, sizeof(light_view_projection.m)) == 0;
+                    if (cache_valid) {
+                        m_shadowStats.shadowCascadesCached++;
                     }
                     else {
-                        packetRenderState.RemoveFlags(RenderStateFlags::BlendEnable);
-                        packetRenderState.AddFlags(RenderStateFlags::DepthWriteEnable);
-                        packetRenderState.AddFlags(RenderStateFlags::DepthTestEnable);
+                        {
+                            StageScope stage("Clear", m_timings.clearMs);
+                            cascade_target.staticDepth->ClearDepth(1.0f);
+                        }
+                        cascade_target.staticCasterCount = DrawShadowCasters(cascade_target.staticTarget, light_view, light_projection, true);
+                        cascade_target.staticViewProjection = light_view_projection;
+                        cascade_target.staticSignature = static_signature;
+                        cascade_target.staticValid = true;
+                        m_shadowStats.shadowCascadesRendered++;
                     }
-                    // ĬϿ޳
-                    packetRenderState.AddFlags(RenderStateFlags::CullFaceEnable);
-
-                    // --- Ҫ: ݴ RenderState  RenderPacket ---
-                    packet.renderState = packetRenderState; // ֱӸֵ
+                }
+                else {
+                    cascade_target.staticValid = false;
+                    cascade_target.staticCasterCount = 0;
+                }
 
-                    // ---  RenderPacket ӵȫб ---
-                    m_renderPackets.push_back(packet); // push_back(packet)
+                // ̬Ͷÿ֡ھ̬ӰĿ (߿յӰͼ) 
+                ShadowCascade& cascade = shadow_maps[l].cascades[c];
+                cascade.viewProjection = light_view_projection;
+                // ȷΧӳ䵽 NDC  [-1, 1]ʱֻСĳƫƣбڵдʱбƫƴ
+                cascade.bias = 1.0f / (float)m_shadowMapSize;
+                if (dynamic_count > 0) {
+                    {
+                        StageScope stage("Clear", m_timings.clearMs);
+                        if (cascade_target.staticCasterCount > 0) cascade_target.depth->CopyDepthFrom(*cascade_target.staticDepth);
+                        else cascade_target.depth->ClearDepth(1.0f);
+                    }
+                    DrawShadowCasters(cascade_target.target, light_view, light_projection, false);
+                    cascade_target.depthCleared = false;
+                    cascade.depth = cascade_target.depth.get();
+                }
+                else if (cascade_target.staticCasterCount > 0) {
+                    cascade.depth = cascade_target.staticDepth.get();
+                }
+                else {
+                    // ûκͶյӰͼһξ͹
+                    if (!cascade_target.depthCleared) {
+                        StageScope stage("Clear", m_timings.clearMs);
+                        cascade_target.depth->ClearDepth(1.0f);
+                        cascade_target.depthCleared = true;
+                    }
+                    cascade.depth = cascade_target.depth.get();
                 }
             }
-            if (!m_renderPackets.empty()) {
-                DistributePacketsToTiles();
+        }
+        m_target = &m_mainTarget;
+        m_passStats = &m_stats;
+        m_shadowMaps = shadow_maps;
+    }
 
-                // --- ޸ RenderTiles֪ǰʲô Pass ---
-                RenderTiles();
-            }
+    size_t Renderer::DrawShadowCasters(RenderTarget& target, const Math::Matrix4f& light_view, const Math::Matrix4f& light_projection, bool is_static) {
+        m_target = &target;
+        target.ResetStats();
+
+        const Math::Matrix4f light_view_projection = light_projection * light_view;
+        size_t drawn = 0;
+        for (const ShadowCaster* caster : m_cascadeCasters) {
+            if (caster->isStatic != is_static) continue;
+            const auto& object = *caster->object;
+
+            DrawUniforms* uniforms = m_frameArena.New<DrawUniforms>();
+            uniforms->model = object.transform;
+            uniforms->view = light_view;
+            uniforms->projection = light_projection;
+            uniforms->mvp = light_view_projection * object.transform;
+
+            RenderState shadowRenderState;
+            shadowRenderState.targetFramebuffer = target.framebuffer;
+            shadowRenderState.lightViewProjectionMatrix = light_view_projection;
+            shadowRenderState.uniforms = uniforms;
+            shadowRenderState.AddFlags(RenderStateFlags::DepthTestEnable);
+            shadowRenderState.AddFlags(RenderStateFlags::DepthWriteEnable);
+            shadowRenderState.AddFlags(RenderStateFlags::DepthOnly);
+            shadowRenderState.AddFlags(RenderStateFlags::CullFaceEnable);
+            // PCF  1 أбƫҪôԶ
+            shadowRenderState.depthBiasSlope = SHADOW_SLOPE_BIAS;
+
+            DrawObject(*object.mesh, m_shadowMapShader, shadowRenderState);
+            drawn++;
         }
+        target.MergeStats(m_shadowStats);
+        return drawn;
+    }
+
+    // ƽ c + dx * X + dy * Y ھ [x0, x1] x [y0, y1] ϵֵ (Ժֵĳȡ)
+    inline float PlaneMax(float dx, float dy, float c, float x0, float x1, float y0, float y1) {
+        return c + std::max(dx * x0, dx * x1) + std::max(dy * y0, dy * y1);
+    }
+
+    // ߿Ƿθǵ (ز)
+    // 궼ԵģֻҪĳһ߿ϵֵС 0߿档
+    // زʱأmargin  0.5 ѲԷΧ
+    bool TileOverlapsTriangle(const Tile& tile, const TriangleSetup& setup, float margin) {
+        // ߿Χֵཻģ԰Χԭ (뽨¼еƽ淽һ)
+        float x0 = (float)(std::max(tile.minX, (int)setup.minX) - setup.minX) - margin;
+        float x1 = (float)(std::min(tile.maxX, (int)setup.maxX) - 1 - setup.minX) + margin;
+        float y0 = (float)(std::max(tile.minY, (int)setup.minY) - setup.minY) - margin;
+        float y1 = (float)(std::min(tile.maxY, (int)setup.maxY) - 1 - setup.minY) + margin;
+
+        // һդʱ b2  1 - b0 - b1 õ˳ͬøǵر©
+        constexpr float epsilon = 1e-4f;
+        if (PlaneMax(setup.b0_dx, setup.b0_dy, setup.b0_c, x0, x1, y0, y1) < -epsilon) return false;
+        if (PlaneMax(setup.b1_dx, setup.b1_dy, setup.b1_c, x0, x1, y0, y1) < -epsilon) return false;
+        if (PlaneMax(-setup.b0_dx - setup.b1_dx, -setup.b0_dy - setup.b1_dy, 1.0f - setup.b0_c - setup.b1_c, x0, x1, y0, y1) < -epsilon) return false;
+        return true;
     }
 
-    // --- : DistributePacketsToTiles  (߼) ---
+    // --- DistributePacketsToTilesη䵽ǵ߿ ---
+    // ¼ύ˳гĿ飬̳߳ϲз
     void Renderer::DistributePacketsToTiles() {
-        // һ֡ķ
-        for (auto& p_list : m_tilePackets) {
-            p_list.clear();
-        }
-
-        int w = m_framebuffer->GetWidth();
-        int h = m_framebuffer->GetHeight();
-
-        // ѴõȾ
-        for (const auto& packet : m_renderPackets) {
-            //  packet ĻΧ
-            float minX_ndc = std::min({ packet.v0.position_clip.x(), packet.v1.position_clip.x(), packet.v2.position_clip.x() });
-            float minY_ndc = std::min({ packet.v0.position_clip.y(), packet.v1.position_clip.y(), packet.v2.position_clip.y() });
-            float maxX_ndc = std::max({ packet.v0.position_clip.x(), packet.v1.position_clip.x(), packet.v2.position_clip.x() });
-            float maxY_ndc = std::max({ packet.v0.position_clip.y(), packet.v1.position_clip.y(), packet.v2.position_clip.y() });
-
-            int tri_min_x = static_cast<int>(std::floor((minX_ndc + 1.0f) * 0.5f * w));
-            int tri_min_y = static_cast<int>(std::floor((minY_ndc + 1.0f) * 0.5f * h));
-            int tri_max_x = static_cast<int>(std::ceil((maxX_ndc + 1.0f) * 0.5f * w));
-            int tri_max_y = static_cast<int>(std::ceil((maxY_ndc + 1.0f) * 0.5f * h));
-
-            // ҵΰΧཻ߿鷶Χ
-            int start_tile_x = std::max(0, tri_min_x / m_tiles[0].maxX); //  TILE_SIZE ̶
-            int end_tile_x = std::min((int)m_tiles.size() / (h / 64) - 1, tri_max_x / m_tiles[0].maxX); // 򻯵Ƭ
-            // ... (ȷƬӣһ򵥱)
-
-            // ߿飬жཻ packet ָӦб
-            for (size_t i = 0; i < m_tiles.size(); ++i) {
-                const auto& tile = m_tiles[i];
-                if (!(tri_max_x < tile.minX || tri_min_x >= tile.maxX ||
-                    tri_max_y < tile.minY || tri_min_y >= tile.maxY))
-                {
-                    m_tilePackets[i].push_back(&packet);
+        auto& pool = Core::ThreadPool::Get();
+        const size_t triangle_count = m_triangleSetups.size();
+        const size_t max_chunks = (size_t)pool.GetThreadCount() + 1;
+        const size_t chunk_count = std::max<size_t>(1, std::min(max_chunks, triangle_count / MIN_TRIANGLES_PER_BIN_CHUNK));
+        const size_t chunk_size = (triangle_count + chunk_count - 1) / chunk_count;
+
+        if (m_binChunks.size() < chunk_count) {
+            m_binChunks.resize(chunk_count);
+        }
+        m_activeBinChunks = chunk_count;
+
+        pool.ParallelFor(chunk_count, [&](size_t k) {
+            MORPHEUS_PROFILE_SCOPE_ARG("BinChunk", k);
+            BinPacketRange(m_binChunks[k], k * chunk_size, std::min(triangle_count, (k + 1) * chunk_size));
+            });
+
+        for (size_t k = 0; k < chunk_count; ++k) {
+            m_passStats->tileBinEntries += m_binChunks[k].tileBinEntries;
+            m_passStats->trianglesBinned += m_binChunks[k].trianglesBinned;
+        }
+    }
+
+    //  m_triangleSetups[begin, end) 䵽 chunk Լ߿б (ֻд chunk鲢)
+    void Renderer::BinPacketRange(BinChunk& chunk, size_t begin, size_t end) {
+        // һεķ (ӷգȶ֮ϵͳڴ)
+        chunk.arena.Reset();
+        const RenderTarget& target = *m_target;
+        chunk.tiles.assign(target.tiles.size(), TileBin());
+        chunk.tileBinEntries = 0;
+        chunk.trianglesBinned = 0;
+        const float sample_margin = (m_multisampleActive && m_target == &m_mainTarget) ? 0.5f : 0.0f;
+
+        for (size_t setup_index = begin; setup_index < end; ++setup_index) {
+            // ֻ 64 ֽڵĽ¼ΧѾڽʱòĻ
+            const TriangleSetup& setup = m_triangleSetups[setup_index];
+
+            // ֱΧиǵ߿Χ ()ٱ߿
+            int start_tile_x = setup.minX / TILE_SIZE;
+            int start_tile_y = setup.minY / TILE_SIZE;
+            int end_tile_x = std::min(target.columns - 1, (setup.maxX - 1) / TILE_SIZE);
+            int end_tile_y = std::min(target.rows - 1, (setup.maxY - 1) / TILE_SIZE);
+
+            // εİΧкܶ߿ʵβཻ (ϸб)ƽɸһ
+            const bool edge_test = (end_tile_x - start_tile_x + 1) * (end_tile_y - start_tile_y + 1) > EDGE_TEST_MIN_TILES;
+
+            bool binned = false;
+            for (int ty = start_tile_y; ty <= end_tile_y; ++ty) {
+                for (int tx = start_tile_x; tx <= end_tile_x; ++tx) {
+                    size_t tile_index = (size_t)ty * target.columns + tx;
+                    if (edge_test && !TileOverlapsTriangle(target.tiles[tile_index], setup, sample_margin)) continue;
+                    TileBin& bin = chunk.tiles[tile_index];
+                    if (!bin.tail || bin.tail->count == BinBlock::CAPACITY) {
+                        BinBlock* block = chunk.arena.New<BinBlock>();
+                        if (bin.tail) bin.tail->next = block;
+                        else bin.head = block;
+                        bin.tail = block;
+                    }
+                    bin.tail->indices[bin.tail->count++] = static_cast<uint32_t>(setup_index);
+                    bin.count++;
+                    chunk.tileBinEntries++;
+                    binned = true;
                 }
             }
+            if (binned) chunk.trianglesBinned++;
         }
     }
 
     // --- RenderTileTask  (ڼЧ) ---
     void Renderer::RenderTileTask(size_t tile_index) {
-        const Tile& tile = m_tiles[tile_index];
-        const std::vector<const RenderPacket*>& packets_for_this_tile = m_tilePackets[tile_index];
+        RenderTarget& target = *m_target;
+        const Tile& tile = target.tiles[tile_index];
+        RenderStats& stats = target.tileStats[tile_index];
+
+        // ֡߿鱾֡һʱ (֮Ļ TouchTile ʲô)
+        if (&target == &m_mainTarget) {
+            for (size_t k = 0; k < m_activeBinChunks; ++k) {
+                if (m_binChunks[k].tiles[tile_index].count == 0) continue;
+                if (m_multisampleActive) m_multisampleBuffer.TouchTile(tile_index);
+                else m_tileBuffer.TouchTile(tile_index);
+                break;
+            }
+        }
+
+        // ˳߿бεύ˳ (Ͻ봮зȫһ)
+        for (size_t k = 0; k < m_activeBinChunks; ++k) {
+            const TileBin& bin = m_binChunks[k].tiles[tile_index];
+            target.tilePacketCounts[tile_index] += bin.count;
 
-        // ֻ߿ġѾɸѡб
-        for (const RenderPacket* packet_ptr : packets_for_this_tile) {
-            // ֱӵùդҪκδ޳
-            RasterizeTriangle(packet_ptr->v0, packet_ptr->v1, packet_ptr->v2, *packet_ptr->shader, tile, packet_ptr->renderState);
+            for (const BinBlock* block = bin.head; block; block = block->next) {
+                for (uint32_t i = 0; i < block->count; ++i) {
+                    // ֱӵùդҪκδ޳դѾڻƿʼʱɫȾ״̬ѡ
+                    const TriangleSetup& setup = m_triangleSetups[block->indices[i]];
+                    (this->*m_draws[setup.drawId].rasterize)(setup, tile, stats);
+                }
+            }
         }
     }
 
     // --- RenderTiles  (ַֻ tile_index) ---
     void Renderer::RenderTiles() {
-        m_threads.clear();
-        for (size_t i = 0; i < m_numThreads; ++i) {
-            m_threads.emplace_back([this, i]() {
-                for (size_t tile_idx = i; tile_idx < m_tiles.size(); tile_idx += m_numThreads) {
-                    RenderTileTask(tile_idx);
+        // ߿鰴ȡǰ̶̹߳䣬æ߿鲻ס߳
+        Core::ThreadPool::Get().ParallelFor(m_target->tiles.size(), [this](size_t tile_idx) {
+            MORPHEUS_PROFILE_SCOPE_ARG("RasterTile", tile_idx);
+            RenderTileTask(tile_idx);
+            });
+    }
+
+    // --- ӳɫĹ Pass ---
+    // դһ߿ָ̳߳أÿ߿ֻдԼ
+    void Renderer::LightGBuffer(const Scene::Scene& scene) {
+        StageScope stage("Lighting", m_timings.lightingMs);
+
+        const auto& camera = scene.GetCamera();
+        const auto& lights = scene.GetDirectionalLights();
+        DeferredLightingParams params;
+        params.inverseViewProjection = (m_frameProjection * camera.GetViewMatrix()).inverse();
+        params.cameraPos = camera.GetPosition();
+        params.lights = lights.data();
+        params.lightCount = lights.size();
+
+        Core::ThreadPool::Get().ParallelFor(m_mainTarget.tiles.size(), [this, &params](size_t tile_idx) {
+            MORPHEUS_PROFILE_SCOPE_ARG("LightTile", tile_idx);
+            LightGBufferTile(tile_idx, params);
+            });
+    }
+
+    // һһдȰ G-buffer 롢ؽ꣬ŽԷֿл壬
+    // ٶÿԴͬ (ڲѭûз֧ûмεعױ˳ 0)
+    void Renderer::LightGBufferTile(size_t tile_index, const DeferredLightingParams& params) {
+        const Tile& tile = m_mainTarget.tiles[tile_index];
+        const Framebuffer& framebuffer = *m_framebuffer;
+        const float width = (float)framebuffer.GetWidth();
+        const float height = (float)framebuffer.GetHeight();
+        const Math::Matrix4f& inv_vp = params.inverseViewProjection;
+        const float ambient = BlinnPhongShader::AMBIENT;
+        const TileLightList tile_lights = m_localLightCount > 0 ? m_tileLights[tile_index] : TileLightList{};
+
+        float nx[TILE_SIZE], ny[TILE_SIZE], nz[TILE_SIZE];       // 
+        float vx[TILE_SIZE], vy[TILE_SIZE], vz[TILE_SIZE];       // ָķ
+        float px[TILE_SIZE], py[TILE_SIZE], pz[TILE_SIZE];       // 
+        float ar[TILE_SIZE], ag[TILE_SIZE], ab[TILE_SIZE];       // albedo
+        float shininess[TILE_SIZE];
+        float coverage[TILE_SIZE];                               // мΪ 1Ϊ 0
+        float visibility[TILE_SIZE];                             // ǰԴĿɼ ( coverage)
+        float lr[TILE_SIZE], lg[TILE_SIZE], lb[TILE_SIZE];       // ֱӹۼ
+        float ldx[TILE_SIZE], ldy[TILE_SIZE], ldz[TILE_SIZE];    // ָǰֲԴķ
+        float attenuation[TILE_SIZE];                            // ǰֲԴ˥ ( coverage)
+        uint64_t pixels_lit = 0;
+
+        // ûлκζ߿ûм
+        if (m_tileBuffer.IsTilePending(tile_index)) return;
+
+        const int count = tile.maxX - tile.minX;
+        const float* tile_depth = m_tileBuffer.TileDepth(tile_index);
+        uint32_t* tile_color = m_tileBuffer.TileColor(tile_index);
+        for (int y = tile.minY; y < tile.maxY; ++y) {
+            // Ⱥɫ߿ֲ (ӳɫز)
+            const float* depth_row = tile_depth + m_tileBuffer.PixelOffset(0, y - tile.minY);
+            uint32_t* color_row = tile_color + m_tileBuffer.PixelOffset(0, y - tile.minY);
+            const uint32_t* normal_row = m_gbuffer.NormalRow(y);
+            const uint32_t* albedo_row = m_gbuffer.AlbedoRow(y);
+            const float* shininess_row = m_gbuffer.ShininessRow(y);
+            const float ndc_y = ((float)y + 0.5f) * 2.0f / height - 1.0f;
+
+            // 1.  G-bufferؽ
+            int covered = 0;
+            for (int i = 0; i < count; ++i) {
+                const int x = tile.minX + i;
+                const float depth = depth_row[i];
+                coverage[i] = depth < 1.0f ? 1.0f : 0.0f;
+                lr[i] = lg[i] = lb[i] = 0.0f;
+                if (coverage[i] == 0.0f) {
+                    nx[i] = ny[i] = vx[i] = vy[i] = 0.0f;
+                    nz[i] = vz[i] = 1.0f;
+                    px[i] = py[i] = pz[i] = 0.0f;
+                    ar[i] = ag[i] = ab[i] = 0.0f;
+                    shininess[i] = 1.0f;
+                    continue;
                 }
-                });
+                covered++;
+
+                const float ndc_x = ((float)x + 0.5f) * 2.0f / width - 1.0f;
+                Math::Vector4f world = inv_vp * Math::Vector4f{ ndc_x, ndc_y, depth, 1.0f };
+                const float inv_w = 1.0f / world.w();
+                px[i] = world.x() * inv_w;
+                py[i] = world.y() * inv_w;
+                pz[i] = world.z() * inv_w;
+                Math::Vector3f view_dir = Math::normalize(params.cameraPos - Math::Vector3f{ px[i], py[i], pz[i] });
+                vx[i] = view_dir.x();
+                vy[i] = view_dir.y();
+                vz[i] = view_dir.z();
+
+                Math::Vector3f normal = GBuffer::DecodeNormal(normal_row[x]);
+                nx[i] = normal.x();
+                ny[i] = normal.y();
+                nz[i] = normal.z();
+                const uint32_t albedo = albedo_row[x];
+                ar[i] = (float)((albedo >> 16) & 0xFF) * (1.0f / 255.0f);
+                ag[i] = (float)((albedo >> 8) & 0xFF) * (1.0f / 255.0f);
+                ab[i] = (float)(albedo & 0xFF) * (1.0f / 255.0f);
+                shininess[i] = shininess_row[x];
+            }
+            if (covered == 0) continue;
+            pixels_lit += covered;
+
+            // 2. Դۼ Blinn-Phong ͸߹
+            for (size_t l = 0; l < params.lightCount; ++l) {
+                const Scene::DirectionalLight& light = params.lights[l];
+                const Math::Vector3f L = Math::normalize(-light.direction);
+                const Math::Vector3f radiance = light.color * light.intensity;
+
+                // Ӱֻмεزѯ͸һΪ޷֧ѭȨ
+                for (int i = 0; i < count; ++i) {
+                    visibility[i] = coverage[i];
+                    if (m_shadowMaps && coverage[i] != 0.0f) visibility[i] = m_shadowMaps[l].Visibility({ px[i], py[i], pz[i] });
+                }
+                for (int i = 0; i < count; ++i) {
+                    float n_dot_l = std::max(0.0f, nx[i] * L.x() + ny[i] * L.y() + nz[i] * L.z());
+                    float hx = L.x() + vx[i], hy = L.y() + vy[i], hz = L.z() + vz[i];
+                    float inv_h = 1.0f / std::sqrt(std::max(hx * hx + hy * hy + hz * hz, 1e-12f));
+                    float n_dot_h = std::max(0.0f, (nx[i] * hx + ny[i] * hy + nz[i] * hz) * inv_h);
+                    float intensity = (n_dot_l + std::pow(n_dot_h, shininess[i])) * visibility[i];
+                    lr[i] += intensity * radiance.x();
+                    lg[i] += intensity * radiance.y();
+                    lb[i] += intensity * radiance.z();
+                }
+            }
+
+            // 3. Ӱ߿ľֲԴȶ㷽˥ (Դ֮ûмεȨΪ 0)
+            // жղʱ߹ⲿ㣺СΧĹԴֻͨ߿ļ
+            for (uint32_t k = 0; k < tile_lights.count; ++k) {
+                const LocalLight& light = m_localLights[tile_lights.indices[k]];
+                float reached = 0.0f;
+                for (int i = 0; i < count; ++i) {
+                    float lx = light.position.x() - px[i], ly = light.position.y() - py[i], lz = light.position.z() - pz[i];
+                    float distance_sq = std::max(lx * lx + ly * ly + lz * lz, 1e-8f);
+                    float inv_distance = 1.0f / std::sqrt(distance_sq);
+                    ldx[i] = lx * inv_distance;
+                    ldy[i] = ly * inv_distance;
+                    ldz[i] = lz * inv_distance;
+                    attenuation[i] = DistanceAttenuation(distance_sq, light.invRange) * SpotAttenuation(light, ldx[i], ldy[i], ldz[i]) * coverage[i];
+                    reached = std::max(reached, attenuation[i]);
+                }
+                if (reached == 0.0f) continue;
+
+                for (int i = 0; i < count; ++i) {
+                    float n_dot_l = std::max(0.0f, nx[i] * ldx[i] + ny[i] * ldy[i] + nz[i] * ldz[i]);
+                    float hx = ldx[i] + vx[i], hy = ldy[i] + vy[i], hz = ldz[i] + vz[i];
+                    float inv_h = 1.0f / std::sqrt(std::max(hx * hx + hy * hy + hz * hz, 1e-12f));
+                    float n_dot_h = std::max(0.0f, (nx[i] * hx + ny[i] * hy + nz[i] * hz) * inv_h);
+                    float intensity = (n_dot_l + std::pow(n_dot_h, shininess[i])) * attenuation[i];
+                    lr[i] += intensity * light.radiance.x();
+                    lg[i] += intensity * light.radiance.y();
+                    lb[i] += intensity * light.radiance.z();
+                }
+            }
+
+            // 4. ( + ֱӹ) * albedoдɫ
+            for (int i = 0; i < count; ++i) {
+                if (coverage[i] == 0.0f) continue;
+                Math::Vector4f color = {
+                    std::clamp((ambient + lr[i]) * ar[i], 0.0f, 1.0f),
+                    std::clamp((ambient + lg[i]) * ag[i], 0.0f, 1.0f),
+                    std::clamp((ambient + lb[i]) * ab[i], 0.0f, 1.0f),
+                    1.0f
+                };
+                color_row[i] = to_color(color);
+            }
+        }
+        m_mainTarget.tileStats[tile_index].pixelsLit += pixels_lit;
+    }
+
+    // --- ֲԴ ---
+    // ѳĵԴ;۹תɫõĸʽ۲ռİΧ򹩷ֿ޳ʹ
+    void Renderer::PrepareLocalLights(const Scene::Scene& scene) {
+        const auto& point_lights = scene.GetPointLights();
+        const auto& spot_lights = scene.GetSpotLights();
+        size_t count = point_lights.size() + spot_lights.size();
+        if (count > MAX_LOCAL_LIGHTS) {
+            SDL_Log("Too many local lights (%zu), only the first %zu are used", count, MAX_LOCAL_LIGHTS);
+            count = MAX_LOCAL_LIGHTS;
+        }
+        m_localLightCount = count;
+        m_stats.localLights = count;
+        if (count == 0) {
+            m_localLights = nullptr;
+            m_localLightBounds = nullptr;
+            return;
+        }
+
+        const auto& camera = scene.GetCamera();
+        const Math::Matrix4f& view = camera.GetViewMatrix();
+        m_cullProjection = m_frameProjection;
+        auto to_view = [&view](const Math::Vector3f& p) { return (view * Math::Vector4f{ p.x(), p.y(), p.z(), 1.0f }).xyz(); };
+
+        LocalLight* lights = m_frameArena.NewArray<LocalLight>(count);
+        LightBounds* bounds = m_frameArena.NewArray<LightBounds>(count);
+        size_t n = 0;
+        for (size_t i = 0; i < point_lights.size() && n < count; ++i, ++n) {
+            const Scene::PointLight& point = point_lights[i];
+            const float range = std::max(point.range, 1e-4f);
+            lights[n] = { point.position, 1.0f / range, point.color * point.intensity, 0.0f, Math::Vector3f{ 0.0f, 0.0f, 0.0f }, 1.0f };
+            bounds[n] = { to_view(point.position), range };
         }
-        for (auto& t : m_threads) {
-            if (t.joinable()) t.join();
+        for (size_t i = 0; i < spot_lights.size() && n < count; ++i, ++n) {
+            const Scene::SpotLight& spot = spot_lights[i];
+            const float range = std::max(spot.range, 1e-4f);
+            const float cos_outer = std::cos(spot.outerConeAngle);
+            const float cos_inner = std::cos(spot.innerConeAngle);
+            const float spot_scale = 1.0f / std::max(cos_inner - cos_outer, 1e-4f);
+            lights[n] = { spot.position, 1.0f / range, spot.color * spot.intensity, spot_scale, spot.direction, -cos_outer * spot_scale };
+
+            // ǰ뾶Ϊ range һԲ׶С 45 ʱþ׶͵Բ
+            // С 90 ʱԵԲΪԲ򣬷˻
+            Math::Vector3f center = spot.position;
+            float radius = range;
+            if (cos_outer > 0.70710678f) {
+                radius = range / (2.0f * cos_outer);
+                center = spot.position + spot.direction * radius;
+            }
+            else if (cos_outer > 0.0f) {
+                radius = range * std::sin(spot.outerConeAngle);
+                center = spot.position + spot.direction * (range * cos_outer);
+            }
+            bounds[n] = { to_view(center), radius };
         }
+        m_localLights = lights;
+        m_localLightBounds = bounds;
     }
 
-    // --- Render ع ---
-    void Renderer::Render(const Scene::Scene& scene) {
-        m_framebuffer->ClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
-        m_framebuffer->ClearDepth(1.0f);
+    // Ϊ֡ÿ߿ɹԴб߿֮以̳߳زд
+    void Renderer::CullLocalLights(TileDepthRange range) {
+        if (m_localLightCount == 0) return;
+        StageScope stage("LightCulling", m_timings.lightCullingMs);
+
+        const size_t tile_count = m_mainTarget.tiles.size();
+        m_tileLights.resize(tile_count);
+        m_tileLightIndices.resize(tile_count * m_localLightCount);
+        Core::ThreadPool::Get().ParallelFor(tile_count, [this, range](size_t tile_idx) {
+            CullLocalLightsTile(tile_idx, range);
+            });
+    }
 
-        // 2. Ⱦ
-        for (size_t i = 0; i < static_cast<size_t>(RenderQueue::Count); ++i) {
-            m_renderQueues[i].clear();
+    // ߿ڹ۲ռһΪ׶ĸ涼ԭ㣻ȷΧسһΣԴΧ
+    void Renderer::CullLocalLightsTile(size_t tile_index, TileDepthRange range) {
+        const Tile& tile = m_mainTarget.tiles[tile_index];
+        const Framebuffer& framebuffer = *m_framebuffer;
+        TileLightList& list = m_tileLights[tile_index];
+        uint16_t* indices = m_tileLightIndices.data() + tile_index * m_localLightCount;
+        list.indices = indices;
+        list.count = 0;
+
+        // 1. ߿ȷΧ (NDC )
+        float min_depth = -1.0f;
+        float max_depth = 1.0f;
+        if (range != TileDepthRange::Frustum) {
+            float nearest = 1.0f;
+            float farthest = -1.0f;
+            // ûмεزᱻ Pass ɫ
+            const bool skip_cleared = range == TileDepthRange::Depth;
+            if (m_multisampleActive) {
+                // زʱȻڲϣҪв
+                m_multisampleBuffer.DepthRange(tile_index, tile.maxX - tile.minX, tile.maxY - tile.minY, skip_cleared, nearest, farthest);
+            }
+            else {
+                m_tileBuffer.DepthRange(tile_index, tile.maxX - tile.minX, tile.maxY - tile.minY, skip_cleared, nearest, farthest);
+            }
+            if (nearest > farthest) return; // ߿鶼ûм
+            if (range == TileDepthRange::Depth) min_depth = nearest;
+            max_depth = farthest;
         }
 
-        const auto& camera = scene.GetCamera();
-        const Math::Vector3f camera_pos = camera.GetPosition();
+        // NDC  -> ľ룺z_ndc = -P22 - P23 / z_view
+        const Math::Matrix4f& P = m_cullProjection;
+        const float min_distance = P.m[2][3] / (min_depth + P.m[2][2]);
+        const float max_distance = P.m[2][3] / (max_depth + P.m[2][2]);
+
+        // 2. ĸ (۲ռ䣬߳߿ڲ)x_ndc >= x0 ȼ P00 * x + (P02 + x0) * z >= 0ͬ
+        const float width = (float)framebuffer.GetWidth();
+        const float height = (float)framebuffer.GetHeight();
+        const float x0 = (float)tile.minX * 2.0f / width - 1.0f;
+        const float x1 = (float)tile.maxX * 2.0f / width - 1.0f;
+        const float y0 = (float)tile.minY * 2.0f / height - 1.0f;
+        const float y1 = (float)tile.maxY * 2.0f / height - 1.0f;
+        const Math::Vector3f planes[4] = {
+            Math::normalize(Math::Vector3f{ P.m[0][0], 0.0f, P.m[0][2] + x0 }),
+            Math::normalize(Math::Vector3f{ -P.m[0][0], 0.0f, -(P.m[0][2] + x1) }),
+            Math::normalize(Math::Vector3f{ 0.0f, P.m[1][1], P.m[1][2] + y0 }),
+            Math::normalize(Math::Vector3f{ 0.0f, -P.m[1][1], -(P.m[1][2] + y1) }),
+        };
 
-        // 3. 
-        for (const auto& object : scene.GetObjects()) {
-            if (!object.mesh || !object.material) continue;
-            float dist_sq = (object.transform[3].xyz() - camera_pos).length_squared();
-            m_renderQueues[static_cast<size_t>(object.material->render_queue)].push_back({ &object, dist_sq });
+        // 3. Χس׶ (ƽԣ丽һЩԴӰȷ)
+        uint32_t count = 0;
+        for (size_t i = 0; i < m_localLightCount; ++i) {
+            const LightBounds& bounds = m_localLightBounds[i];
+            const float distance = -bounds.center.z();
+            if (distance + bounds.radius < min_distance || distance - bounds.radius > max_distance) continue;
+            bool inside = true;
+            for (const Math::Vector3f& plane : planes) {
+                if (Math::dot(plane, bounds.center) < -bounds.radius) {
+                    inside = false;
+                    break;
+                }
+            }
+            if (inside) indices[count++] = (uint16_t)i;
         }
+        list.count = count;
+        m_mainTarget.tileStats[tile_index].tileLightEntries += count;
+    }
 
-        // 4. 
-        auto& opaque_queue = m_renderQueues[static_cast<size_t>(RenderQueue::Opaque)];
-        std::sort(opaque_queue.begin(), opaque_queue.end(), [](const auto& a, const auto& b) {
-            return a.distance_to_camera_sq < b.distance_to_camera_sq; // ӽԶ
+    // --- ˳޹͸ĺϳ ---
+    void Renderer::ResolveOIT() {
+        StageScope stage("OITResolve", m_timings.oitResolveMs);
+        Core::ThreadPool::Get().ParallelFor(m_mainTarget.tiles.size(), [this](size_t tile_idx) {
+            if (!m_oitTileUsed[tile_idx]) return;
+            const Tile& tile = m_mainTarget.tiles[tile_idx];
+            m_oitBuffer.Resolve(*m_framebuffer, tile.minX, tile.minY, tile.maxX, tile.maxY);
+            m_oitTileUsed[tile_idx] = 0;
             });
+    }
 
-        auto& transparent_queue = m_renderQueues[static_cast<size_t>(RenderQueue::Transparent)];
-        std::sort(transparent_queue.begin(), transparent_queue.end(), [](const auto& a, const auto& b) {
-            return a.distance_to_camera_sq > b.distance_to_camera_sq; // Զ
+    // --- زϳ ---
+    void Renderer::ResolveMultisample() {
+        StageScope stage("MultisampleResolve", m_timings.multisampleResolveMs);
+        Core::ThreadPool::Get().ParallelFor(m_mainTarget.tiles.size(), [this](size_t tile_idx) {
+            const Tile& tile = m_mainTarget.tiles[tile_idx];
+            m_multisampleBuffer.ResolveTile(tile_idx, *m_framebuffer, tile.minX, tile.minY, tile.maxX, tile.maxY);
+            });
+    }
+
+    // --- ߿ֲд ---
+    void Renderer::WriteBackTiles() {
+        StageScope stage("WriteBack", m_timings.writeBackMs);
+        Core::ThreadPool::Get().ParallelFor(m_mainTarget.tiles.size(), [this](size_t tile_idx) {
+            const Tile& tile = m_mainTarget.tiles[tile_idx];
+            m_tileBuffer.WriteBackTile(tile_idx, *m_framebuffer, tile.minX, tile.minY, tile.maxX, tile.maxY);
             });
+    }
+
+    // --- ʱ俹ݵĺϳ ---
+    // ߿һ֡ɫȫɺ߿ (Ҫ߿ɫ)
+    void Renderer::ResolveTemporalAA(const Scene::Scene& scene) {
+        StageScope stage("TemporalResolve", m_timings.temporalResolveMs);
+        const auto& camera = scene.GetCamera();
+        m_temporalBuffer.BeginResolve(camera.GetProjectionMatrix() * camera.GetViewMatrix());
+
+        auto& pool = Core::ThreadPool::Get();
+        pool.ParallelFor(m_mainTarget.tiles.size(), [this](size_t tile_idx) {
+            const Tile& tile = m_mainTarget.tiles[tile_idx];
+            m_temporalBuffer.DecodeTile(*m_framebuffer, tile.minX, tile.minY, tile.maxX, tile.maxY);
+            });
+        pool.ParallelFor(m_mainTarget.tiles.size(), [this](size_t tile_idx) {
+            const Tile& tile = m_mainTarget.tiles[tile_idx];
+            m_temporalBuffer.ResolveTile(*m_framebuffer, tile.minX, tile.minY, tile.maxX, tile.maxY);
+            });
+        m_temporalBuffer.EndResolve();
+    }
+
+    // --- Render ع ---
+    void Renderer::Render(const Scene::Scene& scene) {
+        Core::Profiler::Get().BeginFrame();
+        m_timings = FrameTimings();
+        StageScope frame_stage("Render", m_timings.totalMs);
 
-        // 5. ˳ִȾ Pass
-        ProcessRenderQueue(opaque_queue, scene, false);
+        m_stats = RenderStats();
+        m_shadowStats = RenderStats();
+        m_draws.clear();
+        m_frameArena.Reset();
+        m_shadowMaps = nullptr;
+        m_mainTarget.ResetStats();
+        if (m_deferredShading && (m_gbuffer.GetWidth() != m_framebuffer->GetWidth() || m_gbuffer.GetHeight() != m_framebuffer->GetHeight())) {
+            m_gbuffer.Resize(m_framebuffer->GetWidth(), m_framebuffer->GetHeight());
+        }
+        m_multisampleActive = m_multisampling && !m_deferredShading;
+        if (m_multisampleActive && m_multisampleBuffer.GetTileCount() != m_mainTarget.tiles.size()) {
+            m_multisampleBuffer.Resize(m_mainTarget.tiles.size(), TILE_SIZE);
+        }
+        if (!m_multisampleActive && m_tileBuffer.GetTileCount() != m_mainTarget.tiles.size()) {
+            m_tileBuffer.Resize(m_mainTarget.tiles.size(), TILE_SIZE);
+        }
+        // ֡ͶӰʱ俹ʱƽƲһ
+        const auto& frame_camera = scene.GetCamera();
+        if (m_temporalAA) {
+            if (m_temporalBuffer.GetWidth() != m_framebuffer->GetWidth() || m_temporalBuffer.GetHeight() != m_framebuffer->GetHeight()) {
+                m_temporalBuffer.Resize(m_framebuffer->GetWidth(), m_framebuffer->GetHeight());
+            }
+            const Math::Vector2f jitter = TemporalAA::Jitter(m_temporalFrame++);
+            m_frameProjection = frame_camera.GetJitteredProjectionMatrix(
+                jitter.x() * 2.0f / (float)m_framebuffer->GetWidth(), jitter.y() * 2.0f / (float)m_framebuffer->GetHeight());
+        }
+        else {
+            m_frameProjection = frame_camera.GetProjectionMatrix();
+        }
+        const int oit_samples = m_multisampleActive ? MultisampleBuffer::SAMPLE_COUNT : 1;
+        if (m_orderIndependentTransparency && (m_oitBuffer.GetWidth() != m_framebuffer->GetWidth() || m_oitBuffer.GetHeight() != m_framebuffer->GetHeight() ||
+            m_oitBuffer.GetSampleCount() != oit_samples)) {
+            m_oitBuffer.Resize(m_framebuffer->GetWidth(), m_framebuffer->GetHeight(), oit_samples);
+            m_oitTileUsed.assign(m_mainTarget.tiles.size(), 0);
+        }
+
+        {
+            StageScope stage("Clear", m_timings.clearMs);
+            const Math::Vector4f clear_color{ 0.1f, 0.1f, 0.1f, 1.0f };
+            // ֡ɫ֡ĩд (زϳɻ߿д)߿Ĵ洢ڵһλʱգ
+            // ֻǡһֱû߿ϳʱֱֵ
+            const uint32_t packed = to_color(clear_color);
+            if (m_multisampleActive) m_multisampleBuffer.DeferClear(packed, 1.0f);
+            else m_tileBuffer.DeferClear(packed, 1.0f);
+            m_framebuffer->ClearOverdraw();
+        }
+
+        auto& opaque_queue = m_renderQueues[static_cast<size_t>(RenderQueue::Opaque)];
+        auto& transparent_queue = m_renderQueues[static_cast<size_t>(RenderQueue::Transparent)];
+        {
+            StageScope sort_stage("Sort", m_timings.sortMs);
+
+            // 2. Ⱦ
+            for (size_t i = 0; i < static_cast<size_t>(RenderQueue::Count); ++i) {
+                m_renderQueues[i].clear();
+            }
+
+            const auto& camera = scene.GetCamera();
+            const Math::Vector3f camera_pos = camera.GetPosition();
+
+            // 3. 
+            for (const auto& object : scene.GetObjects()) {
+                if (!object.mesh || !object.material) continue;
+                float dist_sq = (object.transform[3].xyz() - camera_pos).length_squared();
+                m_renderQueues[static_cast<size_t>(object.material->render_queue)].push_back({ &object, dist_sq });
+            }
+
+            // 4. 
+            std::sort(opaque_queue.begin(), opaque_queue.end(), [](const auto& a, const auto& b) {
+                return a.distance_to_camera_sq < b.distance_to_camera_sq; // ӽԶ
+                });
+
+            // ˳޹͸Ľ˳޹أҪ
+            if (!m_orderIndependentTransparency) {
+                std::sort(transparent_queue.begin(), transparent_queue.end(), [](const auto& a, const auto& b) {
+                    return a.distance_to_camera_sq > b.distance_to_camera_sq; // Զ
+                    });
+            }
+        }
+
+        // 5. ˳ִȾ Pass (ӰͼȻ͸Ͱ͸ɫʱõ)
+        RenderShadowMaps(scene, opaque_queue);
+        PrepareLocalLights(scene);
+        if (m_deferredShading) {
+            ProcessRenderQueue(opaque_queue, scene, false, QueueFilter::GBufferOnly);
+            //  Pass ֻ G-buffer ɫȷΧյ֮ǰƵƬԪֻ֤еȸԶ
+            CullLocalLights(TileDepthRange::Depth);
+            LightGBuffer(scene);
+            CullLocalLights(TileDepthRange::NearToDepth);
+            ProcessRenderQueue(opaque_queue, scene, false, QueueFilter::ForwardOnly);
+        }
+        else {
+            CullLocalLights(TileDepthRange::Frustum);
+            ProcessRenderQueue(opaque_queue, scene, false);
+            // ͸ֻڲ͸ǰ
+            CullLocalLights(TileDepthRange::NearToDepth);
+        }
         // ProcessRenderQueue(skybox_queue, scene, ...); // δȾպ
         ProcessRenderQueue(transparent_queue, scene, true);
+        if (m_multisampleActive) ResolveMultisample();
+        else WriteBackTiles();
+        if (m_orderIndependentTransparency) ResolveOIT();
+        if (m_temporalAA) ResolveTemporalAA(scene);
+
+        // 6. ϲ߿ͳ
+        m_mainTarget.MergeStats(m_stats);
     }
    
 }
\ No newline at end of file
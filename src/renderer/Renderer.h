@@ -5,7 +5,20 @@
 #include "../scene/Scene.h"
 #include "../math/Matrix.h"
 #include "Material.h"
-#include <thread>
+#include "RenderStats.h"
+#include "ShadowMap.h"
+#include "GBuffer.h"
+#include "LocalLight.h"
+#include "OITBuffer.h"
+#include "MultisampleBuffer.h"
+#include "TileBuffer.h"
+#include "TemporalAA.h"
+#include "shaders/ShadowMapShader.h"
+#include "../core/FrameArena.h"
+#include <chrono>
+#include <cstdint>
+#include <array>
+#include <utility>
 
 // ǰ
 namespace Morpheus::Scene { class Scene; }
@@ -20,47 +33,385 @@ namespace Morpheus::Renderer {
         int minX, minY;
         int maxX, maxY;
     };
-    // ṹȾһϢ
-    struct RenderPacket {
-        Varyings v0, v1, v2;
-        IShader* shader; // ָӦʹõ Shader ʵ
+    // --- ν¼ ---
+    // ͹դѭֻ 64 ֽ (һ)ذΧСƽ桢Ⱥ 1/w
+    // ԼָݺͶԵ±ꡣԷ VaryingStore ֻͨȲԵƬԪŻȥ
+    struct alignas(64) TriangleSetup {
+        int16_t minX, minY, maxX, maxY; // ذΧ [min, max)ѾĻΧ
+        //  b0b1 ƽ淽̣b = c + dx * (x - minX) + dy * (y - minY)
+        // c ǰΧϽĴֵ (԰Χԭ㣬ԶԭҲʧ)b2 = 1 - b0 - b1
+        float b0_dx, b0_dy, b0_c;
+        float b1_dx, b1_dy, b1_c;
+        float z[3];      //  NDC 
+        float inv_w[3];  // üռ w ĵ͸Уֵ
+        uint32_t drawId;        // m_draws ±
+        uint32_t varyingOffset; //  VaryingStore ţǵһ±
+    };
+    static_assert(sizeof(TriangleSetup) == 64, "TriangleSetup should fit in one cache line");
+
+    // ---  (SoA) ---
+    // ÿԵһ飬Ѿ˹ 1/w ֵֵʱֻ谴ȨٳԲֵ w
+    // ֻдɫԣ鹲ͬһ±꣬ûдҪʱ
+    struct VaryingStore {
+        std::vector<Math::Vector3f> color;
+        std::vector<Math::Vector3f> world_pos;
+        std::vector<Math::Vector3f> world_normal;
+        std::vector<Math::Vector2f> uv;
+        std::vector<Math::Vector3f> tangent_space_light_dir;
+        std::vector<Math::Vector3f> tangent_space_view_dir;
+        std::vector<Math::Vector3f> world_tangent;
+
+        size_t Size() const { return count; }
+        void Clear() {
+            count = 0;
+            color.clear();
+            world_pos.clear();
+            world_normal.clear();
+            uv.clear();
+            tangent_space_light_dir.clear();
+            tangent_space_view_dir.clear();
+            world_tangent.clear();
+        }
+        void Push(const Varyings& v, float inv_w, uint32_t varying_mask);
+
+        size_t count = 0; // дĶ
+    };
+
+    class Renderer;
+    // դһһ߿ڵĲ֣ (ɫ x Ⱦ״̬ x Varyings ) ػͬİ汾
+    using RasterizeTriangleFn = void (Renderer::*)(const TriangleSetup&, const Tile&, RenderStats&);
+
+    // һλ (һ) õݣͨ drawId 
+    struct DrawData {
+        IShader* shader = nullptr; // ָӦʹõ Shader ʵ
         RenderState renderState;
+        uint32_t varyingMask = VaryingLayout::All; // shader->GetVaryingMask()
+        RasterizeTriangleFn rasterize = nullptr;   // ÿλѡһΣ֮ÿֱӵ
+    };
+    // һ֡׶εĺʱ ()׼Ժ͵ʾʹ
+    struct FrameTimings {
+        float clearMs = 0.0f;    // ɫ/Ȼ
+        float sortMs = 0.0f;     // 
+        float vertexShadingMs = 0.0f; // ɫ
+        float clippingMs = 0.0f;      // ü͸ӳȾ
+        float binningMs = 0.0f;  // η䵽߿
+        float rasterMs = 0.0f;   // ߿դƬԪɫ
+        float shadowMs = 0.0f;   // Ӱ Pass (еĶɫ䡢դͬʱӦĽ׶)
+        float lightCullingMs = 0.0f; // ֲԴ߿޳
+        float lightingMs = 0.0f; // ӳɫĹ Pass
+        float oitResolveMs = 0.0f; // ˳޹͸ĺϳ
+        float multisampleResolveMs = 0.0f; // زϳɵ֡
+        float temporalResolveMs = 0.0f;    // ʱ俹ݵͶӰʷ
+        float writeBackMs = 0.0f;          // ߿ֲд֡
+        float totalMs = 0.0f;
     };
     class Renderer {
     public:
+        static constexpr int TILE_SIZE = 64;
+        // Χиǵ߿ֵʱ߿ȷཻ
+        static constexpr int EDGE_TEST_MIN_TILES = 4;
+        // зʱÿٰ̫СĿ鲻ֵ÷ָ߳
+        static constexpr size_t MIN_TRIANGLES_PER_BIN_CHUNK = 512;
+        // ÿӰһӰͼĬϱ߳
+        static constexpr int DEFAULT_SHADOW_MAP_SIZE = 1024;
+        static constexpr int DEFAULT_SHADOW_CASCADES = 3;
+        //  (ͬʱԶƽ) 岻ٽӰֻһ׶
+        static constexpr float DEFAULT_SHADOW_DISTANCE = 50.0f;
+        // ڶ (1) ;Ȼ (0) ֮Ĳֵ
+        static constexpr float SHADOW_CASCADE_SPLIT_LAMBDA = 0.75f;
+        // Ӱ Pass бƫ (λÿصȱ仯)
+        static constexpr float SHADOW_SLOPE_BIAS = 2.0f;
+        // ߿Դб 16 λ±꣬ľֲԴ
+        static constexpr size_t MAX_LOCAL_LIGHTS = 65535;
+
         Renderer(int width, int height);
         void Render(const Scene::Scene& scene);
         std::shared_ptr<Framebuffer> GetFramebuffer() const { return m_framebuffer; }
+        const FrameTimings& GetLastFrameTimings() const { return m_timings; }
+        const RenderStats& GetLastFrameStats() const { return m_stats; }
+        // һ֡ÿ߿鴦Ⱦ˳
+        const std::vector<uint32_t>& GetTilePacketCounts() const { return m_mainTarget.tilePacketCounts; }
+        int GetTileColumns() const { return m_mainTarget.columns; }
+        int GetTileRows() const { return m_mainTarget.rows; }
+
+        // --- Ӱ ---
+        // ʱÿ֡ΪÿƽйȾӰͼBlinnPhongShader  PCF Ӱ
+        void SetShadowsEnabled(bool enabled) { m_shadowsEnabled = enabled; }
+        bool AreShadowsEnabled() const { return m_shadowsEnabled; }
+        void SetShadowMapSize(int size);
+        int GetShadowMapSize() const { return m_shadowMapSize; }
+        void SetShadowCascadeCount(int count); // [1, ShadowMap::MAX_CASCADES]
+        int GetShadowCascadeCount() const { return m_shadowCascadeCount; }
+        void SetShadowDistance(float distance) { m_shadowDistance = distance; }
+        float GetShadowDistance() const { return m_shadowDistance; }
+        // --- ӳɫ (ĬϹر) ---
+        // ֧ G-buffer Ĳ͸ֻд G-bufferһ߿鲢е Pass ÿɼһΣ
+        // ͸Ͱ͸ȻǰȾ
+        void SetDeferredShading(bool enabled) { m_deferredShading = enabled; }
+        bool IsDeferredShading() const { return m_deferredShading; }
+        // --- ˳޹͸ (ĬϹر) ---
+        // ͸岻ٰϣȫһ͹դƬԪۼӵ OIT  (Ȩ)
+        // ÿ߿ϳһΡཻصİ͸񲻻Ϊ˳
+        void SetOrderIndependentTransparency(bool enabled) { m_orderIndependentTransparency = enabled; }
+        bool IsOrderIndependentTransparency() const { return m_orderIndependentTransparency; }
+        // 4x ز (ĬϹر)֡ÿ 4 /ɫ㣬ƬԪɫȻÿһΡ
+        // ӳɫʱЧ (G-buffer ͹ Pass ÿһ)
+        void SetMultisampling(bool enabled) { m_multisampling = enabled; }
+        bool IsMultisampling() const { return m_multisampling; }
+        // ʱ俹 (ĬϹر)ͶӰÿ֡ض֡ĩͶӰʷ֡ϡ
+        // ֮ĵһ֡ûʷλʱ ResetTemporalHistory
+        void SetTemporalAA(bool enabled);
+        bool IsTemporalAA() const { return m_temporalAA; }
+        void ResetTemporalHistory() { m_temporalBuffer.Invalidate(); }
+        // һ֡˶ (أһ֡λüȥһ֡λ)ֻʱ俹ݿʱ
+        const std::vector<Math::Vector2f>& GetMotionVectors() const { return m_temporalBuffer.GetMotionVectors(); }
+
+        // ĻռɫͼÿԪضӦ֡һ߿ (GetTileColumns() x GetTileRows()ȣ 0 )
+        // Ƶɫȡʺ߿нϴֵһرգزӳɫ G-buffer Ӱ
+        void SetShadingRateImage(std::vector<ShadingRate> rates);
+        const std::vector<ShadingRate>& GetShadingRateImage() const { return m_shadingRateImage; }
+        // ߿ĵĻĵľ (԰ԽΪ 1) ɫͼinner  1x1outer  2x2 4x4
+        std::vector<ShadingRate> MakePeripheralShadingRateImage(float inner = 0.5f, float outer = 0.8f) const;
+
+        // һ֡Ӱ Pass ͳ ( GetLastFrameStats)
+        const RenderStats& GetLastShadowStats() const { return m_shadowStats; }
 
     private:
         void SetupFrame(const Scene::Scene& scene); // ׼׶Σж
         void RenderTiles(); // Ⱦ׶Σ߳Ⱦ
-        // --- ޸ģRasterizeTriangle Ҫһ shader ---
-        void RasterizeTriangle(const Varyings& v0, const Varyings& v1, const Varyings& v2, IShader& shader, const Tile& tile, const RenderState& renderState);
+        // --- ޸ģRasterizeTriangle ֻս¼shader Ⱦ״̬ͨ drawId  ---
+        // ģڱȷ
+        //   ShaderT     ɫľ (final ࣬FragmentShader 麯)Զɫ IShader
+        //   Flags       Ӱѭ RenderStateFlags (Ȳ/д//ֻд/д G-buffer/OIT ۼ)DYNAMIC_RENDER_STATE ʾʱȡ
+        //   VaryingMask ֵЩԣÿֲһݹդѭ
+        template<typename ShaderT, uint32_t Flags, uint32_t VaryingMask>
+        void RasterizeTriangle(const TriangleSetup& setup, const Tile& tile, RenderStats& stats);
+        // ز汾ǺȲԣд m_multisampleBufferֻ֡дɫĻ
+        // (Ⱦ״̬ DepthOnly  GBufferWrite)
+        template<typename ShaderT, uint32_t Flags, uint32_t VaryingMask>
+        void RasterizeTriangleMultisample(const TriangleSetup& setup, const Tile& tile, RenderStats& stats);
+
+        // դдɫ/飺 (x, y) ± origin + y * rowStep + xÿֻһ׵±ꡣ
+        // ֡ m_tileBuffer ߿Լһ (rowStep Ϊ߿)Ӱͼֱ Framebuffer  (дϵ´洢rowStep Ϊ)
+        struct PixelTarget {
+            uint32_t* color; // ֻдȵĿûɫ
+            float* depth;
+            ptrdiff_t origin;
+            ptrdiff_t rowStep;
+        };
+        PixelTarget GetPixelTarget(size_t tile_index, const Tile& tile);
+
+        // ӰѭȾ״̬λԼϵ (ұĴС)
+        static constexpr uint32_t RASTER_STATE_MASK = static_cast<uint32_t>(RenderStateFlags::DepthWriteEnable) |
+            static_cast<uint32_t>(RenderStateFlags::DepthTestEnable) | static_cast<uint32_t>(RenderStateFlags::BlendEnable) |
+            static_cast<uint32_t>(RenderStateFlags::DepthOnly) | static_cast<uint32_t>(RenderStateFlags::GBufferWrite) |
+            static_cast<uint32_t>(RenderStateFlags::OITAccumulate);
+        static constexpr uint32_t RASTER_STATE_COUNT = RASTER_STATE_MASK + 1;
+        static constexpr uint32_t DYNAMIC_RENDER_STATE = 1u << 31;
+
+        template<typename ShaderT, uint32_t State, bool Multisample>
+        static RasterizeTriangleFn ShaderRasterizer();
+        template<typename ShaderT, bool Multisample, size_t... States>
+        static std::array<RasterizeTriangleFn, sizeof...(States)> MakeShaderRasterizerTable(std::index_sequence<States...>);
+        template<bool Multisample, size_t... Masks>
+        static std::array<RasterizeTriangleFn, sizeof...(Masks)> MakeGenericRasterizerTable(std::index_sequence<Masks...>);
+        // ΪһλѡդɫȾ״̬ɫ Varyings ֲ (Ⱦ״̬ʱж)
+        static RasterizeTriangleFn SelectRasterizer(const IShader& shader, const RenderState& renderState, uint32_t varying_mask, bool multisample);
+        // ͸ӳ֮ǰĲüռ䶥ɽ¼Ͷ (Ϊ߲κĵֱӶ)
+        void AddTriangleSetup(const Varyings& v0, const Varyings& v1, const Varyings& v2, uint32_t draw_id);
+
+        // --- ȾĿ ---
+        // һ֡͸߿֡ÿӰͼһ͹դ m_target
+        struct RenderTarget {
+            Framebuffer* framebuffer = nullptr;
+            std::vector<Tile> tiles; // 
+            int columns = 0;
+            int rows = 0;
+            std::vector<RenderStats> tileStats; // ÿ߿Ĺդ׶μ
+            std::vector<uint32_t> tilePacketCounts;
+
+            void Init(Framebuffer* target); //  TILE_SIZE ߿
+            void ResetStats();
+            void MergeStats(RenderStats& out) const; // ۼӸ߿ļдÿ߿Ⱦֵ/ƽֵ
+        };
 
         std::shared_ptr<Framebuffer> m_framebuffer;
-        // 洢о VSü͸ӳζ
-        std::vector<RenderPacket> m_renderPackets;    // <-- һ滻
-        // --- ĺݽṹ ---
-        //  m_tiles һһӦ
-        // ÿԪһ vector洢ָ m_renderPackets Ԫصָ롣
-        std::vector<std::vector<const RenderPacket*>> m_tilePackets;
+        RenderTarget m_mainTarget;
+        RenderTarget* m_target = &m_mainTarget;
+        RenderStats* m_passStats = &m_stats; // ǰ Pass ν׶εļд
+        // 洢о VSü͸ӳ
+        std::vector<TriangleSetup> m_triangleSetups;
+        VaryingStore m_varyings;
+        std::vector<DrawData> m_draws; // ֡лƣdrawId ±
+        // ֡ڷÿ֡ʼʱ ResetÿλƵ DrawUniforms ֻһ֡
+        Core::FrameArena m_frameArena;
+
+        // --- ֿ߿б (з) ---
+        // m_triangleSetups гĿ飬ÿһ̶߳䵽Լ߿б
+        // դĳ߿ʱ˳ζȡбõľԭύ˳򣬲Ҫϲ򿽱
+        // ߿бһ̶ BinBlockӿԼӷ (ÿֻһ̷߳ʣ䲻Ҫͬ)
+        struct BinBlock {
+            static constexpr uint32_t CAPACITY = 61; //  BinBlock  256 ֽ
+            BinBlock* next;
+            uint32_t count;
+            uint32_t indices[CAPACITY]; // m_triangleSetups ±
+        };
+        struct TileBin {
+            BinBlock* head = nullptr;
+            BinBlock* tail = nullptr;
+            uint32_t count = 0;
+        };
+        struct BinChunk {
+            Core::FrameArena arena;       // ÿ·߿ʱ Reset
+            std::vector<TileBin> tiles;   //  m_target->tiles һ
+            uint64_t tileBinEntries = 0;
+            uint64_t trianglesBinned = 0;
+        };
+        std::vector<BinChunk> m_binChunks;
+        size_t m_activeBinChunks = 0; // ηʵʹõĿ (Ŀ鱣´θ)
 
         // --- ĺ ---
         void DistributePacketsToTiles();
+        void BinPacketRange(BinChunk& chunk, size_t begin, size_t end);
 
         // --- ޸ RenderTileTask ǩ ---
         // ڽһ tile_index Tile 
         void RenderTileTask(size_t tile_index);
 
         // --- ̹߳ ---
+        // ߿齻ȫ̳߳زȾ (߳Ҳ)ÿ Pass /߳
         unsigned int m_numThreads;
-        std::vector<std::thread> m_threads;
-        std::vector<Tile> m_tiles;
 
-        void ProcessRenderQueue(const std::vector<RenderCommand>& queue, const Scene::Scene& scene, bool is_transparent_pass);
+        // ǰ徭ɫ֮Ķ ( mesh.vertices һһӦ)
+        std::vector<Varyings> m_shadedVertices;
+
+        // ӳɫʱ͸зδȻд G-buffer 壬֮ǰ
+        enum class QueueFilter { All, GBufferOnly, ForwardOnly };
+        void ProcessRenderQueue(const std::vector<RenderCommand>& queue, const Scene::Scene& scene, bool is_transparent_pass,
+            QueueFilter filter = QueueFilter::All);
+        // һˮߣɫüν䡢դ m_target
+        void DrawObject(const Mesh& mesh, IShader& shader, const RenderState& renderState);
+        // ֻɫüν׷ m_triangleSetups  (ύ)
+        void SubmitObject(const Mesh& mesh, IShader& shader, const RenderState& renderState);
+        // ύη䵽߿鲢դȻ
+        void FlushTriangles();
+
+        // --- Ӱ Pass ---
+        // ׶ (ӰΪֹ) гɶΣÿƽйΪÿȾһżӰͼ m_shadowMaps
+        // Ͷǲ͸壬ÿֻĹԴռΧཻͶ
+        void RenderShadowMaps(const Scene::Scene& scene, const std::vector<RenderCommand>& casters);
+        //  m_cascadeCasters ﾲ̬Ϊ is_static Ͷֻдȵػ targetػ˼
+        size_t DrawShadowCasters(RenderTarget& target, const Math::Matrix4f& light_view, const Math::Matrix4f& light_projection, bool is_static);
+
+        struct ShadowCaster {
+            const Scene::SceneObject* object;
+            Math::Vector3f center; // ռΧ
+            float radius;
+            bool isStatic;
+        };
+        std::vector<ShadowCaster> m_shadowCasters; // ֡Ͷ
+        std::vector<const ShadowCaster*> m_cascadeCasters; // 뵱ǰཻͶ
+
+        // һӰͼ̬Ͷﵥ staticDepth ﲢ֡棺
+        // Դռ;̬嶼ûʱֱӸãж̬Ͷʱȿٰ̬Ѷ̬廭ȥ
+        struct ShadowCascadeTarget {
+            std::unique_ptr<Framebuffer> depth;       // ֡յӰͼ (ֻȻ)
+            RenderTarget target;
+            std::unique_ptr<Framebuffer> staticDepth; // ֻо̬Ͷһ̬Ͷʱ
+            RenderTarget staticTarget;
+            Math::Matrix4f staticViewProjection;      // staticDepth ʱõľ
+            uint64_t staticSignature = 0;             // Լʱ̬ǩ
+            size_t staticCasterCount = 0;
+            bool staticValid = false;
+            bool depthCleared = false; // depth ֮û
+        };
+        std::vector<ShadowCascadeTarget> m_shadowTargets; // ± Դ *  + 
+        ShadowMapShader m_shadowMapShader;
+        bool m_shadowsEnabled = true;
+        int m_shadowMapSize = DEFAULT_SHADOW_MAP_SIZE;
+        int m_shadowCascadeCount = DEFAULT_SHADOW_CASCADES;
+        float m_shadowDistance = DEFAULT_SHADOW_DISTANCE;
+        const ShadowMap* m_shadowMaps = nullptr; // ֡Ӱͼ (֡ڷ)ûӰʱΪ
+
+        // --- ӳɫ ---
+        //  Pass ÿ֡õĲ
+        struct DeferredLightingParams {
+            Math::Matrix4f inverseViewProjection; // NDC -> ռ
+            Math::Vector3f cameraPos;
+            const Scene::DirectionalLight* lights;
+            size_t lightCount;
+        };
+        void LightGBuffer(const Scene::Scene& scene);
+        void LightGBufferTile(size_t tile_index, const DeferredLightingParams& params);
+        bool m_deferredShading = false;
+        GBuffer m_gbuffer;
+
+        // --- ֲԴķֿ޳ ---
+        // ÿ֡ѳĵԴ;۹ת LocalLightΪ֡ÿ߿г׶ཻĹԴ
+        // ɫ (ǰƬԪɫӳٵĹ Pass) ֻԼ߿б
+        // ߿׶ȷΧȡ֮ҪɫЩƬԪ
+        enum class TileDepthRange {
+            Frustum,     // ƽ浽Զƽ (ûлκβ͸)
+            NearToDepth, // ƽ浽߿Զ (֮ƬԪҪͨȲԣеȸԶ)
+            Depth,       // ߿Զ (ֻѾд G-buffer ɫ)
+        };
+        void PrepareLocalLights(const Scene::Scene& scene);
+        void CullLocalLights(TileDepthRange range);
+        void CullLocalLightsTile(size_t tile_index, TileDepthRange range);
+
+        // Դڹ۲ռİΧ (۹ðסԲ׶С)
+        struct LightBounds {
+            Math::Vector3f center;
+            float radius;
+        };
+        const LocalLight* m_localLights = nullptr;    // ֡ڷ
+        const LightBounds* m_localLightBounds = nullptr;
+        size_t m_localLightCount = 0;
+        std::vector<TileLightList> m_tileLights;      //  m_mainTarget.tiles һһӦ
+        std::vector<uint16_t> m_tileLightIndices;     // ÿ߿ռ m_localLightCount λã߿鲢дԼһ
+        Math::Matrix4f m_cullProjection;              // ޳õͶӰ (֡)
+
+        // --- ˳޹͸ ---
+        // ߿鲢кϳɣֻ֡а͸ƬԪ߿飬ϳ֮ OIT 帴λ
+        void ResolveOIT();
+        bool m_orderIndependentTransparency = false;
+        OITBuffer m_oitBuffer;
+        std::vector<uint8_t> m_oitTileUsed; //  m_mainTarget.tiles һһӦդʱɸ߿߳д
+
+        // --- ز ---
+        // ֡Ļд m_multisampleBuffer (߿ m_mainTarget.tiles һһӦ)
+        // 廭֮߿ϳɵ m_framebuffer˳޹͸ںϳ֮Ͻ
+        void ResolveMultisample();
+        bool m_multisampling = false;
+        bool m_multisampleActive = false; // ֡Ƿز (ûӳɫ)
+        MultisampleBuffer m_multisampleBuffer;
+
+        // --- ߿ֲ ---
+        // زʱ֡Ļ ( G-buffer Ⱥ͹ Pass ɫ) д m_tileBuffer
+        // 廭֮߿д m_framebuffer˳޹͸ʱ俹д֮Ͻ
+        void WriteBackTiles();
+        TileBuffer m_tileBuffer;
+
+        // --- ʱ俹 ---
+        // m_frameProjection Ǳ֡֡õͶӰ (ʱ)ӰȻԭ׶֡
+        // ϳϳ (ز˳޹͸) ֮
+        void ResolveTemporalAA(const Scene::Scene& scene);
+        bool m_temporalAA = false;
+        uint32_t m_temporalFrame = 0; // е±
+        TemporalAA m_temporalBuffer;
+        Math::Matrix4f m_frameProjection;
+
+        // --- ɱɫ ---
+        //  m_mainTarget.tiles һһӦΪձʾûɫͼ (ֻòʵɫ)
+        std::vector<ShadingRate> m_shadingRateImage;
 
         // --- Ⱦ ---
         std::vector<RenderCommand> m_renderQueues[static_cast<size_t>(RenderQueue::Count)];
+
+        FrameTimings m_timings;
+
+        // --- ͳ ---
+        RenderStats m_stats;       // ν׶εļ֡ʱϲդ׶εļ
+        RenderStats m_shadowStats; // Ӱ Pass ļ (Ӱͼܺ)
     };
 }
@@ -0,0 +1,53 @@
+// src/renderer/ShadowMap.h (ļ)
+#pragma once
+#include "Framebuffer.h"
+#include "../math/Matrix.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Morpheus::Renderer {
+
+    // --- һӰ ---
+    // depth ֻȻ Framebuffer ( Renderer ӵ)viewProjection 任ԴĲüռ (ͶӰw = 1)
+    struct ShadowCascade {
+        const Framebuffer* depth = nullptr;
+        Math::Matrix4f viewProjection;
+        float bias = 0.0f; // NDC ϵĳƫƣԼڵԼ (shadow acne)
+    };
+
+    // --- һƽйļӰͼ ---
+    // ɽԶУԽļǵķΧԽСֱԽ
+    struct ShadowMap {
+        static constexpr int MAX_CASCADES = 4;
+        ShadowCascade cascades[MAX_CASCADES];
+        int cascadeCount = 0;
+
+        // 㱻Դı [0, 1]3x3 PCF
+        // ʹõһ PCF Χҵ㲻ԴԶƽ֮ļ (Ժļ)
+        // мĵûڵȫ
+        float Visibility(const Math::Vector3f& world_pos) const {
+            for (int c = 0; c < cascadeCount; ++c) {
+                const ShadowCascade& cascade = cascades[c];
+                Math::Vector4f p = cascade.viewProjection * Math::Vector4f{ world_pos.x(), world_pos.y(), world_pos.z(), 1.0f };
+
+                const int w = cascade.depth->GetWidth();
+                const int h = cascade.depth->GetHeight();
+                // դͬӿڱ任 (x, y)  x + 0.5
+                int cx = (int)std::floor((p.x() + 1.0f) * 0.5f * w);
+                int cy = (int)std::floor((p.y() + 1.0f) * 0.5f * h);
+                if (cx < 1 || cx >= w - 1 || cy < 1 || cy >= h - 1) continue;
+                if (p.z() > 1.0f) continue;
+
+                const float reference = p.z() - cascade.bias;
+                int lit = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (reference <= cascade.depth->GetDepth(cx + dx, cy + dy)) lit++;
+                    }
+                }
+                return (float)lit * (1.0f / 9.0f);
+            }
+            return 1.0f;
+        }
+    };
+}
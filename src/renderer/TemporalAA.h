@@ -0,0 +1,182 @@
+// src/renderer/TemporalAA.h (ļ)
+#pragma once
+#include "Framebuffer.h"
+#include "../math/Matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Morpheus::Renderer {
+
+    // --- ʱ俹 (TAA) ---
+    // ͶӰÿ֡ Jitter ƽƲһأͬһ֡ڲͬλϣ
+    // ϳʱһ֡ɫͶӰһ֡λõʷɫϣ֡൱ÿȡ˶
+    // ˶ֻȰػԭռ䣬һ֡Ĺ۲ͶӰͶӰȥ ()
+    // ʷɫڵǰ 3x3 ɫΧڣڵϵ仯ʱӰ
+    // ϳɷȰһ֡ɫɸػ (Ҫ߿ɫ֮Ҫ߿)
+    // ʷݣÿ֡һдһݡ
+    // Լ Framebuffer ͬ (y )± y * width + x
+    class TemporalAA {
+    public:
+        // еĳ (Halton(2, 3) ǰѭʹ)
+        static constexpr uint32_t JITTER_SEQUENCE_LENGTH = 8;
+        // һ֡ɫڻռıԽСԽƽ仯ʱԽ
+        static constexpr float CURRENT_FRAME_WEIGHT = 0.1f;
+
+        void Resize(int width, int height) {
+            m_width = width;
+            m_height = height;
+            const size_t count = (size_t)width * height;
+            for (auto& history : m_history) history.assign(count, Math::Vector3f{ 0.0f, 0.0f, 0.0f });
+            m_motion.assign(count, Math::Vector2f{ 0.0f, 0.0f });
+            m_frame.assign(count, Math::Vector3f{ 0.0f, 0.0f, 0.0f });
+            m_historyValid = false;
+        }
+        // ʷ (һֻ֡Լɫ)տ TAA 
+        void Invalidate() { m_historyValid = false; }
+
+        int GetWidth() const { return m_width; }
+        int GetHeight() const { return m_height; }
+        // һκϳʱÿص˶ ()һ֡λüȥһ֡λ
+        const std::vector<Math::Vector2f>& GetMotionVectors() const { return m_motion; }
+
+        //  frame ֡ضλأΧ [-0.5, 0.5)
+        static Math::Vector2f Jitter(uint32_t frame) {
+            const uint32_t index = frame % JITTER_SEQUENCE_LENGTH + 1; // Halton д 1 ʼ0 ԭ
+            return { Halton(index, 2) - 0.5f, Halton(index, 3) - 0.5f };
+        }
+
+        // ϳɿʼǰãview_projection һ֡Ĺ۲ͶӰ
+        void BeginResolve(const Math::Matrix4f& view_projection) {
+            m_viewProjection = view_projection;
+            // һ֡ NDC -> һ֡Ĳüռ
+            m_reprojection = m_previousViewProjection * view_projection.inverse();
+        }
+
+        // һ [minX, maxX) x [minY, maxY) ɫɸڶʱֱãظ
+        void DecodeTile(const Framebuffer& framebuffer, int minX, int minY, int maxX, int maxY) {
+            constexpr float scale = 1.0f / 255.0f;
+            for (int y = minY; y < maxY; ++y) {
+                const uint32_t* row = framebuffer.GetColorRow(y);
+                Math::Vector3f* out = m_frame.data() + (size_t)y * m_width;
+                for (int x = minX; x < maxX; ++x) {
+                    // ȡе㣬ɫʱдȥԭֵ
+                    const uint32_t c = row[x];
+                    out[x] = {
+                        ((float)((c >> 16) & 0xFF) + 0.5f) * scale,
+                        ((float)((c >> 8) & 0xFF) + 0.5f) * scale,
+                        ((float)(c & 0xFF) + 0.5f) * scale
+                    };
+                }
+            }
+        }
+
+        // ڶ (߿鶼֮)ͶӰϣдһ֡ʷ framebuffer
+        void ResolveTile(Framebuffer& framebuffer, int minX, int minY, int maxX, int maxY) {
+            const std::vector<Math::Vector3f>& history = m_history[m_current ^ 1];
+            std::vector<Math::Vector3f>& output = m_history[m_current];
+            const float to_ndc_x = 2.0f / (float)m_width;
+            const float to_ndc_y = 2.0f / (float)m_height;
+            const float half_width = 0.5f * (float)m_width;
+            const float half_height = 0.5f * (float)m_height;
+            const Math::Matrix4f& R = m_reprojection;
+
+            for (int y = minY; y < maxY; ++y) {
+                const float ndc_y = ((float)y + 0.5f) * to_ndc_y - 1.0f;
+                const float* depth_row = framebuffer.GetDepthRow(y);
+                uint32_t* color_row = framebuffer.GetColorRow(y);
+                // ͶӰ ndc_x Եģһÿμһ
+                const float ndc_x0 = ((float)minX + 0.5f) * to_ndc_x - 1.0f;
+                float row_x = R.m[0][0] * ndc_x0 + R.m[0][1] * ndc_y + R.m[0][3];
+                float row_y = R.m[1][0] * ndc_x0 + R.m[1][1] * ndc_y + R.m[1][3];
+                float row_w = R.m[3][0] * ndc_x0 + R.m[3][1] * ndc_y + R.m[3][3];
+                const float step_x = R.m[0][0] * to_ndc_x;
+                const float step_y = R.m[1][0] * to_ndc_x;
+                const float step_w = R.m[3][0] * to_ndc_x;
+
+                for (int x = minX; x < maxX; ++x, row_x += step_x, row_y += step_y, row_w += step_w) {
+                    const size_t index = (size_t)y * m_width + x;
+                    const Math::Vector3f current = m_frame[index];
+
+                    // 1. ˶
+                    const float ndc_z = depth_row[x];
+                    const float clip_w = row_w + R.m[3][2] * ndc_z;
+                    const float inv_w = 1.0f / clip_w;
+                    const float previous_x = ((row_x + R.m[0][2] * ndc_z) * inv_w + 1.0f) * half_width;
+                    const float previous_y = ((row_y + R.m[1][2] * ndc_z) * inv_w + 1.0f) * half_height;
+                    m_motion[index] = { (float)x + 0.5f - previous_x, (float)y + 0.5f - previous_y };
+
+                    // 2. ʷɫ (˫)һ֡Ļûʷʱֻһ֡
+                    const float hx = previous_x - 0.5f;
+                    const float hy = previous_y - 0.5f;
+                    Math::Vector3f result = current;
+                    if (m_historyValid && clip_w > 0.0f && hx >= 0.0f && hy >= 0.0f && hx <= (float)(m_width - 1) && hy <= (float)(m_height - 1)) {
+                        const int x0 = (int)hx;
+                        const int y0 = (int)hy;
+                        const int x1 = std::min(x0 + 1, m_width - 1);
+                        const int y1 = std::min(y0 + 1, m_height - 1);
+                        const float fx = hx - (float)x0;
+                        const float fy = hy - (float)y0;
+                        const float w00 = (1.0f - fx) * (1.0f - fy), w10 = fx * (1.0f - fy), w01 = (1.0f - fx) * fy, w11 = fx * fy;
+                        const Math::Vector3f& h00 = history[(size_t)y0 * m_width + x0];
+                        const Math::Vector3f& h10 = history[(size_t)y0 * m_width + x1];
+                        const Math::Vector3f& h01 = history[(size_t)y1 * m_width + x0];
+                        const Math::Vector3f& h11 = history[(size_t)y1 * m_width + x1];
+                        const int nx0 = std::max(x - 1, 0), nx1 = std::min(x + 1, m_width - 1);
+                        const int ny0 = std::max(y - 1, 0), ny1 = std::min(y + 1, m_height - 1);
+                        // ͨдɱѭ (Ȱ min/max )
+                        float blended[3];
+                        for (int c = 0; c < 3; ++c) {
+                            float previous = h00[c] * w00 + h10[c] * w10 + h01[c] * w01 + h11[c] * w11;
+                            // 3.  3x3 ɫΧ
+                            float lo = current[c], hi = current[c];
+                            for (int ny = ny0; ny <= ny1; ++ny) {
+                                const Math::Vector3f* neighbors = m_frame.data() + (size_t)ny * m_width;
+                                for (int nx = nx0; nx <= nx1; ++nx) {
+                                    lo = std::min(lo, neighbors[nx][c]);
+                                    hi = std::max(hi, neighbors[nx][c]);
+                                }
+                            }
+                            previous = std::min(std::max(previous, lo), hi);
+                            blended[c] = previous + (current[c] - previous) * CURRENT_FRAME_WEIGHT;
+                        }
+                        result = { blended[0], blended[1], blended[2] };
+                    }
+                    output[index] = result;
+                    color_row[x] = (to_color({ result.x(), result.y(), result.z(), 0.0f }) & 0x00FFFFFFu) | (color_row[x] & 0xFF000000u); // alpha ֲ
+                }
+            }
+        }
+
+        // һ֡ĽΪһ֡ʷ
+        void EndResolve() {
+            m_current ^= 1;
+            m_previousViewProjection = m_viewProjection;
+            m_historyValid = true;
+        }
+
+    private:
+        static float Halton(uint32_t index, uint32_t base) {
+            float result = 0.0f;
+            float fraction = 1.0f / (float)base;
+            while (index > 0) {
+                result += (float)(index % base) * fraction;
+                index /= base;
+                fraction /= (float)base;
+            }
+            return result;
+        }
+
+        int m_width = 0;
+        int m_height = 0;
+        std::vector<Math::Vector3f> m_history[2];
+        int m_current = 0; // һ֡д m_history[m_current]һ
+        std::vector<Math::Vector2f> m_motion;
+        std::vector<Math::Vector3f> m_frame; // һ֡ɫ
+        bool m_historyValid = false;
+        Math::Matrix4f m_viewProjection;
+        Math::Matrix4f m_previousViewProjection;
+        Math::Matrix4f m_reprojection;
+    };
+}
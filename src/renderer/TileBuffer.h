@@ -0,0 +1,118 @@
+// src/renderer/TileBuffer.h (ļ)
+#pragma once
+#include "Framebuffer.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Morpheus::Renderer {
+
+    // --- ߿ֲɫ/Ȼ ---
+    // زʱ֡Ļд廭֮ÿ߿д Framebuffer һΡ
+    // ÿ߿ɫȸһ 64 ֽڶڴ (߿ȣy ϣ Framebuffer 귽ͬ)
+    // դ̴߳һ߿ʱֻԼһΣ߿鲻ͬһϣҲֻһڴ档
+    // дͨпд֮˳޹͸ʱ俹ݺʾҪ framebufferƹʽд뷴
+    // ӳٵģDeferClear ֵֻ߿飬߿һҪʱɸ߳ (TouchTile)
+    // һֱû߿дʱֱֵ framebufferԼĴ洢ȫᱻʡ
+    // Ե߿ҲС䣬֡ĲֲᱻдҲᱻд
+    class TileBuffer {
+    public:
+        void Resize(size_t tile_count, int tile_size) {
+            m_tileCount = tile_count;
+            m_tileSize = tile_size;
+            m_tileStride = (size_t)tile_size * tile_size;
+            m_depth.assign(tile_count * m_tileStride + ALIGN_PADDING, 1.0f);
+            m_color.assign(tile_count * m_tileStride + ALIGN_PADDING, 0u);
+            m_depthOffset = AlignOffset(m_depth.data());
+            m_colorOffset = AlignOffset(m_color.data());
+            m_pending.assign(tile_count, 0);
+        }
+
+        size_t GetTileCount() const { return m_tileCount; }
+        int GetTileSize() const { return m_tileSize; }
+
+        // ߿ (lx, ly) ߿±
+        size_t PixelOffset(int lx, int ly) const { return (size_t)ly * m_tileSize + lx; }
+        float* TileDepth(size_t tile_index) { return m_depth.data() + m_depthOffset + tile_index * m_tileStride; }
+        uint32_t* TileColor(size_t tile_index) { return m_color.data() + m_colorOffset + tile_index * m_tileStride; }
+        const float* TileDepth(size_t tile_index) const { return m_depth.data() + m_depthOffset + tile_index * m_tileStride; }
+        const uint32_t* TileColor(size_t tile_index) const { return m_color.data() + m_colorOffset + tile_index * m_tileStride; }
+
+        // ߿Ϊ (ÿ֡ʼʱ)
+        void DeferClear(uint32_t color, float depth) {
+            m_clearColor = color;
+            m_clearDepth = depth;
+            std::fill(m_pending.begin(), m_pending.end(), uint8_t(1));
+        }
+        // ߿黹ûʱգд߿֮ǰ (ֻɸ߿̵߳)
+        void TouchTile(size_t tile_index) {
+            if (!m_pending[tile_index]) return;
+            std::fill_n(TileDepth(tile_index), m_tileStride, m_clearDepth);
+            std::fill_n(TileColor(tile_index), m_tileStride, m_clearColor);
+            m_pending[tile_index] = 0;
+        }
+        // ֡ûб (ݾֵ洢ﻹǾ)
+        bool IsTilePending(size_t tile_index) const { return m_pending[tile_index] != 0; }
+
+        // ߿ (طΧ [minX, maxX) x [minY, maxY)) ɫд framebuffer
+        void WriteBackTile(size_t tile_index, Framebuffer& framebuffer, int minX, int minY, int maxX, int maxY) const {
+            const int count = maxX - minX;
+            if (m_pending[tile_index]) {
+                for (int y = minY; y < maxY; ++y) {
+                    std::fill_n(framebuffer.GetColorRow(y) + minX, count, m_clearColor);
+                    std::fill_n(framebuffer.GetDepthRow(y) + minX, count, m_clearDepth);
+                }
+                return;
+            }
+            const uint32_t* tile_color = TileColor(tile_index);
+            const float* tile_depth = TileDepth(tile_index);
+            for (int y = minY; y < maxY; ++y) {
+                const size_t row_offset = PixelOffset(0, y - minY);
+                std::copy_n(tile_color + row_offset, count, framebuffer.GetColorRow(y) + minX);
+                std::copy_n(tile_depth + row_offset, count, framebuffer.GetDepthRow(y) + minX);
+            }
+        }
+
+        // ߿ (½ width x height ) ȷΧskip_cleared ʱûмε ( >= 1)
+        void DepthRange(size_t tile_index, int width, int height, bool skip_cleared, float& nearest, float& farthest) const {
+            if (m_pending[tile_index]) {
+                if (skip_cleared && m_clearDepth >= 1.0f) return;
+                nearest = std::min(nearest, m_clearDepth);
+                farthest = std::max(farthest, m_clearDepth);
+                return;
+            }
+            const float* tile_depth = TileDepth(tile_index);
+            for (int ly = 0; ly < height; ++ly) {
+                const float* depth = tile_depth + PixelOffset(0, ly);
+                for (int i = 0; i < width; ++i) {
+                    if (skip_cleared && depth[i] >= 1.0f) continue;
+                    nearest = std::min(nearest, depth[i]);
+                    farthest = std::max(farthest, depth[i]);
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t CACHE_LINE = 64;
+        static constexpr size_t ALIGN_PADDING = CACHE_LINE / sizeof(uint32_t); // Ԫأ뵽
+
+        template<typename T>
+        static size_t AlignOffset(const T* data) {
+            static_assert(sizeof(T) == sizeof(uint32_t), "tile buffers hold 32-bit elements");
+            const size_t misalignment = reinterpret_cast<uintptr_t>(data) % CACHE_LINE;
+            return misalignment == 0 ? 0 : (CACHE_LINE - misalignment) / sizeof(T);
+        }
+
+        size_t m_tileCount = 0;
+        int m_tileSize = 0;
+        size_t m_tileStride = 0; // һ߿
+        std::vector<float> m_depth;
+        std::vector<uint32_t> m_color;
+        size_t m_depthOffset = 0; // һ߿ m_depth  (ж)
+        size_t m_colorOffset = 0;
+        std::vector<uint8_t> m_pending; // ÿ߿һǣդʱɸ߿߳д
+        uint32_t m_clearColor = 0;
+        float m_clearDepth = 1.0f;
+    };
+}
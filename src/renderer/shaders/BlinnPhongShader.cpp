@@ -1,109 +1,90 @@
 #include "BlinnPhongShader.h"
 #include "../Vertex.h"
 #include "../../scene/Light.h" // LightĶ
+#include "../ShadowMap.h"
+#include "../LocalLight.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 
 namespace Morpheus::Renderer {
 
-    Varyings BlinnPhongShader::VertexShader(const Vertex& in) {
+    Varyings BlinnPhongShader::VertexShader(const Vertex& in, const RenderState& renderState) {
         Varyings out;
 
         //  uniforms ȡ
-        auto model_matrix = std::any_cast<Math::Matrix4f>(uniforms["u_model"]);
-        auto mvp_matrix = std::any_cast<Math::Matrix4f>(uniforms["u_mvp"]);
+        const DrawUniforms& u = *renderState.uniforms;
+        const Math::Matrix4f& model_matrix = u.model;
+        const Math::Matrix4f& mvp_matrix = u.mvp;
 
         // 1. üռ
         out.position_clip = mvp_matrix * Math::Vector4f{ in.position.x(), in.position.y(), in.position.z(), 1.0f };
+        // ռλãڼ߷ (֮ǰûиֵ߷ȡδʼڴ)
+        out.world_pos = (model_matrix * Math::Vector4f{ in.position.x(), in.position.y(), in.position.z(), 1.0f }).xyz();
 		out.uv = in.texCoords; // 
-        // ---  TBN  ---
-    // 1. ȡռ N, T
-        Math::Vector3f T = Math::normalize((model_matrix * Math::Vector4f{ in.tangent.x(), in.tangent.y(), in.tangent.z(), 0.0f }).xyz());
-        Math::Vector3f N = Math::normalize((std::any_cast<Math::Matrix4f>(uniforms["u_normal_matrix"]) * Math::Vector4f{ in.normal.x(), in.normal.y(), in.normal.z(), 0.0f }).xyz());
-        // 2. ͨ¼ B֤
-        Math::Vector3f B = Math::normalize(Math::cross(N, T));
-
-        // 3.  TBN  (ռ䵽߿ռ)
-        //  view תá
-        // Ϊ TBN תá
-        Math::Matrix3f TBN;
-        /*TBN[0] = { T.x(), T.y(), T.z() };
-        TBN[1] = { B.x(), B.y(), B.z() };
-        TBN[2] = { N.x(), N.y(), N.z() };*/
-        //todoֵ̫ˣŻһ
-		TBN[0][0] = T.x(); TBN[0][1] = T.y(); TBN[0][2] = T.z();
-		TBN[1][0] = B.x(); TBN[1][1] = B.y(); TBN[1][2] = B.z();
-		TBN[2][0] = N.x(); TBN[2][1] = N.y(); TBN[2][2] = N.z();
-
-        // --- 任߿ռ ---
-        auto lights = std::any_cast<std::vector<Scene::DirectionalLight>>(uniforms["u_lights"]);
-        if (!lights.empty()) {
-            Math::Vector3f light_dir_world = Math::normalize(-lights[0].direction);
-            out.tangent_space_light_dir = TBN * light_dir_world;
-        }
-
-        auto camera_pos = std::any_cast<Math::Vector3f>(uniforms["u_camera_pos"]);
-        Math::Vector3f view_dir_world = Math::normalize(camera_pos - out.world_pos);
-        out.tangent_space_view_dir = TBN * view_dir_world;
+        // --- ռ N, T ---
+        // ͼƬԪòֵ TBN 任ռ䣬Ҳռ
+        // (֮ǰѹշ任߿ռ䣬ֻܱʾһ̶ĹԴԴ;۹ƵķÿƬԪͬ)
+        out.world_tangent = Math::normalize((model_matrix * Math::Vector4f{ in.tangent.x(), in.tangent.y(), in.tangent.z(), 0.0f }).xyz());
+        out.world_normal = Math::normalize((u.normal_matrix * Math::Vector4f{ in.normal.x(), in.normal.y(), in.normal.z(), 0.0f }).xyz());
         return out;
     }
 
     Math::Vector4f BlinnPhongShader::FragmentShader(const Varyings& in, const RenderState& renderState) {
         // --- 1. ȡ Albedo ɫ ---
         // ս˵Ļɫ
-        auto albedo_factor = std::any_cast<Math::Vector4f>(uniforms["u_albedo_factor"]);
-        auto albedo_tex = std::any_cast<std::shared_ptr<Texture>>(uniforms["u_albedo_texture"]);
-		float alpha_factor = std::any_cast<float>(uniforms["u_alpha_factor"]);
-        Math::Vector4f albedo_color = albedo_factor; // Ĭʹɫ
+        const DrawUniforms& u = *renderState.uniforms;
+        const Texture* albedo_tex = u.albedo_texture;
+        Math::Vector4f albedo_color = u.albedo_factor; // Ĭʹɫ
         if (albedo_tex) {
             albedo_color = albedo_tex->Sample(in.uv.x(), in.uv.y());
         }
 
-        // --- 2. ȡ (޸) ---
-        // ӷͼڣʹĬϷ
-        auto normal_tex = std::any_cast<std::shared_ptr<Texture>>(uniforms["u_normal_texture"]);
-        Math::Vector3f tangent_space_normal;
-        if (normal_tex) {
-            // ͼ [0, 1] ɫΧӳ [-1, 1] ķΧ
-            tangent_space_normal = (normal_tex->Sample(in.uv.x(), in.uv.y()).xyz() * 2.0f) - Math::Vector3f{ 1.0f, 1.0f, 1.0f };
-            tangent_space_normal = Math::normalize(tangent_space_normal);
-        }
-        else {
-            // ûзͼʹZΪߡ
-            // ߿ռУ(0,0,1) ʹδ޸ĵġģ͵ļη߷
-            tangent_space_normal = { 0.0f, 0.0f, 1.0f };
-        }
-
-        // --- 3. ׼ռ (ڶ߿ռ) ---
-        Math::Vector3f normal = tangent_space_normal; // ڹյķ
-        Math::Vector3f light_dir = Math::normalize(in.tangent_space_light_dir);
-        Math::Vector3f view_dir = Math::normalize(in.tangent_space_view_dir);
+        // --- 2. ȡ (ռ) ---
+        Math::Vector3f normal = ShadingNormal(in, u);
+        Math::Vector3f view_dir = Math::normalize(u.camera_pos - in.world_pos);
 
         // --- ӻ ---
-        // a. ߿ռ䷨
+        // a. ռ䷨
         //return {(normal.x() + 1.0f) * 0.5f, (normal.y() + 1.0f) * 0.5f, (normal.z() + 1.0f) * 0.5f, 1.0f};
 
         // b. UV
         // return {in.uv.x(), in.uv.y(), 0.0f, 1.0f};
 
-        // --- 4. ʼռ ---
-        auto lights = std::any_cast<std::vector<Scene::DirectionalLight>>(uniforms["u_lights"]);
-        auto shininess = std::any_cast<float>(uniforms["u_shininess"]);
+        // --- 3. ʼռ ---
+        const float shininess = u.shininess;
 
-        Math::Vector3f ambient = { 0.1f, 0.1f, 0.1f }; // ⣬Ϊ uniform 
+        Math::Vector3f ambient = { AMBIENT, AMBIENT, AMBIENT }; // ⣬Ϊ uniform 
         Math::Vector3f total_light_contribution = { 0.0f, 0.0f, 0.0f };
 
-        for (const auto& light : lights) {
-            //  (Diffuse)
+        //  + ߹ (Blinn-Phong)light_dir ָԴĵλ
+        auto blinn_phong = [&](const Math::Vector3f& light_dir) {
             float diff_factor = std::max(0.0f, Math::dot(normal, light_dir));
-            Math::Vector3f diffuse = diff_factor * light.color * light.intensity;
-
-            // ߹ (Specular - Blinn-Phong)
             Math::Vector3f halfway_dir = Math::normalize(light_dir + view_dir);
             float spec_factor = std::pow(std::max(0.0f, Math::dot(normal, halfway_dir)), shininess);
-            Math::Vector3f specular = spec_factor * light.color * light.intensity;
+            return diff_factor + spec_factor;
+        };
+
+        for (size_t i = 0; i < u.light_count; ++i) {
+            const Scene::DirectionalLight& light = u.lights[i];
+            // Ӱֻڵֱӹ⣬ⲻӰ
+            float visibility = u.shadow_maps ? u.shadow_maps[i].Visibility(in.world_pos) : 1.0f;
+            float intensity = blinn_phong(-light.direction) * visibility;
+            total_light_contribution = total_light_contribution + light.color * (light.intensity * intensity);
+        }
 
-            total_light_contribution = total_light_contribution + diffuse + specular;
+        // --- 4. ֲԴֻӰ߿Щ ---
+        if (in.tile_lights) {
+            for (uint32_t k = 0; k < in.tile_lights->count; ++k) {
+                const LocalLight& light = u.local_lights[in.tile_lights->indices[k]];
+                Math::Vector3f to_light = light.position - in.world_pos;
+                float distance_sq = std::max(to_light.length_squared(), 1e-8f);
+                Math::Vector3f light_dir = to_light * (1.0f / std::sqrt(distance_sq));
+                float attenuation = DistanceAttenuation(distance_sq, light.invRange) *
+                    SpotAttenuation(light, light_dir.x(), light_dir.y(), light_dir.z());
+                if (attenuation <= 0.0f) continue;
+                total_light_contribution = total_light_contribution + light.radiance * (blinn_phong(light_dir) * attenuation);
+            }
         }
 
         // --- 5. ɫ ---
@@ -118,6 +99,31 @@ namespace Morpheus::Renderer {
         final_color_rgb.y() = std::clamp(final_color_rgb.y(), 0.0f, 1.0f);
         final_color_rgb.z() = std::clamp(final_color_rgb.z(), 0.0f, 1.0f);
         
-        return { final_color_rgb.x(), final_color_rgb.y(), final_color_rgb.z(), albedo_color.w() * alpha_factor};
+        return { final_color_rgb.x(), final_color_rgb.y(), final_color_rgb.z(), albedo_color.w() * u.alpha_factor};
+    }
+
+    GBufferSample BlinnPhongShader::GBufferFragment(const Varyings& in, const RenderState& renderState) {
+        const DrawUniforms& u = *renderState.uniforms;
+        GBufferSample out;
+
+        Math::Vector4f albedo_color = u.albedo_texture ? u.albedo_texture->Sample(in.uv.x(), in.uv.y()) : u.albedo_factor;
+        out.albedo = albedo_color.xyz();
+        out.shininess = u.shininess;
+
+        out.normal = ShadingNormal(in, u);
+        return out;
+    }
+
+    Math::Vector3f BlinnPhongShader::ShadingNormal(const Varyings& in, const DrawUniforms& u) {
+        // ֵ֮ķߺ߲ Gram-Schmidt ֮ٱ任ͼ
+        Math::Vector3f N = Math::normalize(in.world_normal);
+        if (u.normal_texture) {
+            Math::Vector3f T = Math::normalize(in.world_tangent - N * Math::dot(N, in.world_tangent));
+            Math::Vector3f B = Math::cross(N, T);
+            // ͼ [0, 1] ɫΧӳ [-1, 1] ķΧ
+            Math::Vector3f n = (u.normal_texture->Sample(in.uv.x(), in.uv.y()).xyz() * 2.0f) - Math::Vector3f{ 1.0f, 1.0f, 1.0f };
+            N = Math::normalize(T * n.x() + B * n.y() + N * n.z());
+        }
+        return N;
     }
 }
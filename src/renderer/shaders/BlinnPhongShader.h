@@ -2,9 +2,26 @@
 #include "../IShader.h"
 
 namespace Morpheus::Renderer {
-    class BlinnPhongShader : public IShader {
+    class BlinnPhongShader final : public IShader {
     public:
-        Varyings VertexShader(const Vertex& in) override;
+        // ռ㣺ͼòֵ TBN 任ռ䣬ھֲԴķ/˥ͲѯӰͼ
+        static constexpr uint32_t VARYING_MASK = VaryingLayout::UV | VaryingLayout::WorldNormal | VaryingLayout::WorldTangent |
+            VaryingLayout::WorldPos;
+        // ӳɫʱ FS ֻԣ֮ȫ Pass 
+        static constexpr uint32_t GBUFFER_VARYING_MASK = VaryingLayout::UV | VaryingLayout::WorldNormal | VaryingLayout::WorldTangent;
+        //  (ǰӳɫ)
+        static constexpr float AMBIENT = 0.1f;
+
+        Varyings VertexShader(const Vertex& in, const RenderState& renderState) override;
         Math::Vector4f FragmentShader(const Varyings& in, const RenderState& renderState) override;
+        uint32_t GetVaryingMask() const override { return VARYING_MASK; }
+
+        bool SupportsGBuffer() const override { return true; }
+        GBufferSample GBufferFragment(const Varyings& in, const RenderState& renderState) override;
+        uint32_t GetGBufferVaryingMask() const override { return GBUFFER_VARYING_MASK; }
+
+    private:
+        // ռɫ (зͼʱ TBN 任)
+        static Math::Vector3f ShadingNormal(const Varyings& in, const DrawUniforms& u);
     };
 }
@@ -2,16 +2,11 @@
 #include "../Vertex.h"
 
 namespace Morpheus::Renderer {
-    Varyings ShadowMapShader::VertexShader(const Vertex& in) {
+    Varyings ShadowMapShader::VertexShader(const Vertex& in, const RenderState& renderState) {
         Varyings out;
-        auto light_space_mvp = std::any_cast<Math::Matrix4f>(uniforms["u_light_space_mvp"]);
+        // Ӱ Pass  mvp ǹԴռ model-view-projection
+        const Math::Matrix4f& light_space_mvp = renderState.uniforms->mvp;
         out.position_clip = light_space_mvp * Math::Vector4f{ in.position.x(), in.position.y(), in.position.z(), 1.0f };
         return out;
     }
-
-    Math::Vector4f ShadowMapShader::FragmentShader(const Varyings& in, const RenderState& renderState) {
-        // ƬԪɫʲôΪֻ
-        // һ޹ؽҪɫ
-        return { 0.0f, 0.0f, 0.0f, 1.0f };
-    }
 }
@@ -2,9 +2,18 @@
 #include "../IShader.h"
 
 namespace Morpheus::Renderer {
-    class ShadowMapShader : public IShader {
+    class ShadowMapShader final : public IShader {
     public:
-        Varyings VertexShader(const Vertex& in) override;
-        Math::Vector4f FragmentShader(const Varyings& in, const RenderState& renderState) override;
+        // ֻдȣҪκβֵ
+        static constexpr uint32_t VARYING_MASK = VaryingLayout::None;
+        static constexpr uint32_t GBUFFER_VARYING_MASK = VaryingLayout::None; // ֧ӳɫ
+
+        Varyings VertexShader(const Vertex& in, const RenderState& renderState) override;
+        Math::Vector4f FragmentShader([[maybe_unused]] const Varyings& in, [[maybe_unused]] const RenderState& renderState) override {
+            // ƬԪɫʲôΪֻ
+            // һ޹ؽҪɫ
+            return { 0.0f, 0.0f, 0.0f, 1.0f };
+        }
+        uint32_t GetVaryingMask() const override { return VARYING_MASK; }
     };
 }
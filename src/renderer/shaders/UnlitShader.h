@@ -4,9 +4,16 @@
 
 namespace Morpheus::Renderer {
 
-    class UnlitShader : public IShader {
+    // finalģդֱӵ () FragmentShader麯
+    class UnlitShader final : public IShader {
     public:
-        Varyings VertexShader(const Vertex& in) override;
-        Math::Vector4f FragmentShader(const Varyings& in, const RenderState& renderState) override;
+        static constexpr uint32_t VARYING_MASK = VaryingLayout::Color;
+        static constexpr uint32_t GBUFFER_VARYING_MASK = VaryingLayout::None; // ֧ӳɫ
+
+        Varyings VertexShader(const Vertex& in, const RenderState& renderState) override;
+        Math::Vector4f FragmentShader(const Varyings& in, [[maybe_unused]] const RenderState& renderState) override {
+            return { in.color.x(), in.color.y(), in.color.z(), 1.0f };
+        }
+        uint32_t GetVaryingMask() const override { return VARYING_MASK; }
     };
 }
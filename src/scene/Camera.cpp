@@ -15,6 +15,10 @@ namespace Morpheus::Scene {
 
     void Camera::SetPerspective(float fov_degrees, float aspect, float zNear, float zFar) {
         float fov_rad = fov_degrees * 3.14159265f / 180.0f;
+        m_fovY = fov_rad;
+        m_aspect = aspect;
+        m_near = zNear;
+        m_far = zFar;
         m_projectionMatrix = Math::Matrix4f::Perspective(fov_rad, aspect, zNear, zFar);
     }
 
@@ -50,5 +54,15 @@ namespace Morpheus::Scene {
 
     const Math::Matrix4f& Camera::GetViewMatrix() const { return m_viewMatrix; }
     const Math::Matrix4f& Camera::GetProjectionMatrix() const { return m_projectionMatrix; }
+
+    Math::Matrix4f Camera::GetJitteredProjectionMatrix(float jitter_x, float jitter_y) const {
+        // x_ndc = x_clip / w_clipƽ jitter_x  x_clip  jitter_x * w_clip (y ͬ)
+        Math::Matrix4f jittered = m_projectionMatrix;
+        for (int i = 0; i < 4; ++i) {
+            jittered.m[0][i] += jitter_x * m_projectionMatrix.m[3][i];
+            jittered.m[1][i] += jitter_y * m_projectionMatrix.m[3][i];
+        }
+        return jittered;
+    }
     const Math::Vector3f& Camera::GetPosition() const { return m_position; }
 }
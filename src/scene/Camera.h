@@ -17,7 +17,14 @@ namespace Morpheus::Scene {
         // --- Getters ---
         const Math::Matrix4f& GetViewMatrix() const;
         const Math::Matrix4f& GetProjectionMatrix() const;
+        // ͶӰ NDC ƽ (jitter_x, jitter_y)ʱ俹ݵض (ƽһ 2 / ӿڿ)
+        Math::Matrix4f GetJitteredProjectionMatrix(float jitter_x, float jitter_y) const;
         const Math::Vector3f& GetPosition() const;
+        // SetPerspective Ĳ (ӳΪ)Ӱǻ׶
+        float GetFovY() const { return m_fovY; }
+        float GetAspect() const { return m_aspect; }
+        float GetNear() const { return m_near; }
+        float GetFar() const { return m_far; }
 
         // Called by CameraController to update the view matrix
         void UpdateViewMatrix();
@@ -29,5 +36,10 @@ namespace Morpheus::Scene {
         Math::Vector3f m_position;
         Math::Vector3f m_focalPoint;
         Math::Vector3f m_upVector;
+
+        float m_fovY = 0.785398f; // 45 
+        float m_aspect = 1.0f;
+        float m_near = 0.1f;
+        float m_far = 100.0f;
     };
 }
@@ -4,12 +4,29 @@
 
 namespace Morpheus::Scene {
 
-    // ַֻ֧
+    // ⣺ûλã (Ͷ伶Ӱ)
     struct DirectionalLight {
-        Math::Vector3f direction;
+        Math::Vector3f direction; // λ (ʱһ)
         Math::Vector3f color;
         float intensity;
     };
 
-    // δչ PointLight, SpotLight 
+    // Դƽ˥ range ƽؽ 0range ֮ȫӰ (Կ԰߿޳)
+    struct PointLight {
+        Math::Vector3f position;
+        Math::Vector3f color;
+        float intensity;
+        float range;
+    };
+
+    // ۹ƣڵԴĻϳ׶˥׶Ϊ 1׶Ǵ 0
+    struct SpotLight {
+        Math::Vector3f position;
+        Math::Vector3f direction; // λ
+        Math::Vector3f color;
+        float intensity;
+        float range;
+        float innerConeAngle; // ǣ
+        float outerConeAngle;
+    };
 }
@@ -1,10 +1,13 @@
 // src/scene/Scene.cpp (ļ)
 #include "Scene.h"
+#include <algorithm>
 #include <fstream>
-#include <sstream>
+#include <filesystem>
 #include <nlohmann/json.hpp>
-#include <iostream>
 #include "../renderer/IShader.h"
+#include "../core/ThreadPool.h"
+#include "../core/MappedFile.h"
+#include <future>
 #include <SDL.h>
 
 using json = nlohmann::json;
@@ -41,39 +44,154 @@ namespace Morpheus::Scene {
         return transform;
     }
 
-    Scene Scene::Load(const std::string& filepath) {
-        Scene scene;
-        std::ifstream f(filepath);
-        if (!f.is_open()) {
+    // --- ļȡ ---
+    // ߴ JSON ԶԱһ MessagePack գ´ֱӶ
+    constexpr uint64_t SCENE_SNAPSHOT_MIN_SIZE = 1 << 20;
+
+    bool HasExtension(const std::string& path, const std::string& ext) {
+        return path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+    }
+
+    // һζ (ڴӳ) ļ
+    // .msgpack / .cbor Ƹʽһɵ JSON ı
+    json ParseSceneDocument(const std::string& filepath) {
+        auto file = Core::MappedFile::Open(filepath);
+        if (!file) {
             throw std::runtime_error("Failed to open scene file: " + filepath);
         }
+        const unsigned char* begin = file->GetData();
+        const unsigned char* end = begin + file->GetSize();
 
-        // --- ӵԴ ---
-		std::stringstream buffer;
-        buffer << f.rdbuf();
-        std::string file_content = buffer.str();
+        if (HasExtension(filepath, ".msgpack")) {
+            return json::from_msgpack(begin, end);
+        }
+        if (HasExtension(filepath, ".cbor")) {
+            return json::from_cbor(begin, end);
+        }
 
-        // ʹSDL_LogVSڴӡֱöϵ鿴
-        SDL_Log("--- Start of Scene File Content ---");
-        SDL_Log(file_content.c_str());
-        SDL_Log("--- End of Scene File Content ---");
+        // ļֻڵ־´ӡ󳡾ļˢ
+        if (SDL_LogGetPriority(SDL_LOG_CATEGORY_APPLICATION) <= SDL_LOG_PRIORITY_DEBUG) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "--- Scene File Content (%s) ---\n%.*s",
+                filepath.c_str(), static_cast<int>(file->GetSize()), reinterpret_cast<const char*>(begin));
+        }
+        return json::parse(begin, end);
+    }
 
-        // ļĶȡλõͷ
-        f.seekg(0);
-        // -------------------------
+    // ȡĵ JSON ʹñԴļµ <scene>.msgpack գûʱ JSON д
+    json LoadSceneDocument(const std::string& filepath) {
+        std::error_code ec;
+        uint64_t source_size = std::filesystem::file_size(filepath, ec);
+        if (ec || !HasExtension(filepath, ".json") || source_size < SCENE_SNAPSHOT_MIN_SIZE) {
+            return ParseSceneDocument(filepath);
+        }
 
-        json data = json::parse(f);
+        std::string snapshot_path = filepath + ".msgpack";
+        auto source_time = std::filesystem::last_write_time(filepath, ec);
+        auto snapshot_time = std::filesystem::last_write_time(snapshot_path, ec);
+        if (!ec && snapshot_time >= source_time) {
+            try {
+                return ParseSceneDocument(snapshot_path);
+            }
+            catch (const json::exception& e) {
+                SDL_Log("Warning: Ignoring broken scene snapshot '%s': %s", snapshot_path.c_str(), e.what());
+            }
+        }
+
+        json data = ParseSceneDocument(filepath);
+        Scene::WriteSnapshot(data, snapshot_path);
+        return data;
+    }
+
+    void Scene::WriteSnapshot(const json& data, const std::string& snapshotPath) {
+        std::vector<std::uint8_t> bytes = HasExtension(snapshotPath, ".cbor") ? json::to_cbor(data) : json::to_msgpack(data);
+        // дʱļ (ͬ񻺴)ͬʱȡʱ/дһĿ
+        const std::string temp_path = Core::MakeTempPath(snapshotPath);
+        std::error_code ec;
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            out.close();
+            if (!out) {
+                SDL_Log("Warning: Could not write scene snapshot '%s'.", snapshotPath.c_str());
+                std::filesystem::remove(temp_path, ec);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temp_path, snapshotPath, ec);
+        if (ec) {
+            SDL_Log("Warning: Could not write scene snapshot '%s': %s", snapshotPath.c_str(), ec.message().c_str());
+            std::filesystem::remove(temp_path, ec);
+        }
+    }
+
+    Scene Scene::Load(const std::string& filepath) {
+        Scene scene;
+        scene.m_sourcePath = filepath;
+        scene.Build(LoadSceneDocument(filepath));
+        //  SDL_Log (stderr)  stdoutȾʱ stdout ԭʼ֡
+        SDL_Log("Scene loaded. %zu objects.", scene.m_objects.size());
+        return scene;
+    }
+
+    // ݳĵʡ͵ƹ
+    // //Shader еԴֱӸãسļʱֻõԴŻᱻ
+    void Scene::Build(const json& data) {
+        m_objects.clear();
+        m_directionalLights.clear();
+        m_pointLights.clear();
+        m_spotLights.clear();
+        m_materialCache.clear();
 
         // 
         if (data.contains("camera")) {
             const auto& cam_data = data["camera"];
             Math::Vector3f pos = { cam_data["position"][0], cam_data["position"][1], cam_data["position"][2] };
             Math::Vector3f focal = { cam_data["focal_point"][0], cam_data["focal_point"][1], cam_data["focal_point"][2] };
-            scene.m_camera.SetPosition(pos);
-            scene.m_camera.SetFocalPoint(focal);
-            scene.m_camera.UpdateViewMatrix();
+            m_camera.SetPosition(pos);
+            m_camera.SetFocalPoint(focal);
+            m_camera.UpdateViewMatrix();
+        }
+
+        // --- 첽ԤȡԴ ---
+        // ɨһʺ壬õȫ̳߳زм (JPEG  OBJ Ĵͷ)
+        // װ/ʱֻȴԼҪǼ future
+        auto& pool = Core::ThreadPool::Get();
+        std::map<std::string, std::shared_future<std::shared_ptr<Renderer::Mesh>>> pending_meshes;
+        std::map<std::string, std::shared_future<std::shared_ptr<Renderer::Texture>>> pending_textures;
+
+        // ͨύ
+        if (data.contains("objects")) {
+            for (const auto& obj_data : data["objects"]) {
+                std::string mesh_path = obj_data["mesh"];
+                if (m_meshCache.count(mesh_path) || pending_meshes.count(mesh_path)) continue;
+                pending_meshes[mesh_path] = pool.Submit([mesh_path]() {
+                    return std::make_shared<Renderer::Mesh>(Renderer::Mesh::Load(mesh_path));
+                    }).share();
+            }
+        }
+        if (data.contains("materials")) {
+            for (const auto& mat_data : data["materials"]) {
+                for (const char* key : { "albedo_texture", "normal_texture" }) {
+                    if (!mat_data.contains(key)) continue;
+                    std::string texture_path = mat_data[key];
+                    if (m_textureCache.count(texture_path) || pending_textures.count(texture_path)) continue;
+                    pending_textures[texture_path] = pool.Submit([texture_path]() {
+                        return Renderer::Texture::Load(texture_path);
+                        }).share();
+                }
+            }
         }
 
+        // ӻȡûʱȴӦļ
+        auto resolve_texture = [&](const std::string& texture_path) {
+            auto it = m_textureCache.find(texture_path);
+            if (it == m_textureCache.end()) {
+                it = m_textureCache.emplace(texture_path, pending_textures.at(texture_path).get()).first;
+            }
+            return it->second;
+        };
+
         // ز
         if (data.contains("materials")) {
             for (const auto& mat_data : data["materials"]) {
@@ -104,22 +222,13 @@ namespace Morpheus::Scene {
                 // 2.  Albedo  (ĺ߼)
                 if (mat_data.contains("albedo_texture")) {
                     std::string texture_path = mat_data["albedo_texture"];
-
-                    // 棬ظ
-                    if (scene.m_textureCache.find(texture_path) == scene.m_textureCache.end()) {
-                        // ûУͼµ
-                        scene.m_textureCache[texture_path] = Renderer::Texture::Load(texture_path);
-                    }
-                    mat->albedo_texture = scene.m_textureCache[texture_path];
+                    mat->albedo_texture = resolve_texture(texture_path);
                 }
 
 				// 2. طͼ (еĻ)
                 if (mat_data.contains("normal_texture")) {
                     std::string normal_texture_path = mat_data["normal_texture"];
-                    if (scene.m_textureCache.find(normal_texture_path) == scene.m_textureCache.end()) {
-                        scene.m_textureCache[normal_texture_path] = Renderer::Texture::Load(normal_texture_path);
-                    }
-                    mat->normal_texture = scene.m_textureCache[normal_texture_path];
+                    mat->normal_texture = resolve_texture(normal_texture_path);
 				}
 
                 // ---  render_queue ---
@@ -144,18 +253,35 @@ namespace Morpheus::Scene {
                     mat->specular_shininess = mat_data["specular_shininess"];
                 }
 
+                // ɫ ("1x1" / "2x2" / "4x4")
+                if (mat_data.contains("shading_rate")) {
+                    std::string rate_name = mat_data["shading_rate"];
+                    if (rate_name == "1x1") {
+                        mat->shading_rate = Renderer::ShadingRate::Rate1x1;
+                    }
+                    else if (rate_name == "2x2") {
+                        mat->shading_rate = Renderer::ShadingRate::Rate2x2;
+                    }
+                    else if (rate_name == "4x4") {
+                        mat->shading_rate = Renderer::ShadingRate::Rate4x4;
+                    }
+                    else {
+                        throw std::runtime_error("Unknown shading rate: " + rate_name);
+                    }
+                }
+
                 // ---  Shader (ⲿ߼) ---
                 if (mat_data.contains("shader")) {
                     std::string shader_name = mat_data["shader"];
-                    if (scene.m_shaderCache.find(shader_name) == scene.m_shaderCache.end()) {
+                    if (m_shaderCache.find(shader_name) == m_shaderCache.end()) {
                         if (s_shaderFactory.count(shader_name)) {
-                            scene.m_shaderCache[shader_name] = s_shaderFactory[shader_name]();
+                            m_shaderCache[shader_name] = s_shaderFactory[shader_name]();
                         }
                         else {
                             throw std::runtime_error("Shader not registered: " + shader_name);
                         }
                     }
-                    mat->shader = scene.m_shaderCache[shader_name];
+                    mat->shader = m_shaderCache[shader_name];
                 }
                 else {
                     // ûָshader׳ָһĬϵ
@@ -163,7 +289,7 @@ namespace Morpheus::Scene {
                 }
 
                 // մõĲʴʻ
-                scene.m_materialCache[material_name] = mat;
+                m_materialCache[material_name] = mat;
             }
         }
 
@@ -173,21 +299,24 @@ namespace Morpheus::Scene {
                 SceneObject obj;
                 obj.name = obj_data["name"];
                 obj.transform = parse_transform(obj_data["transform"]);
+                if (obj_data.contains("static")) {
+                    obj.isStatic = obj_data["static"];
+                }
 
-                // ӻļMesh
+                // ӻȡ MeshûʱȴӦļ
                 std::string mesh_path = obj_data["mesh"];
-                if (scene.m_meshCache.find(mesh_path) == scene.m_meshCache.end()) {
-                    scene.m_meshCache[mesh_path] = std::make_shared<Renderer::Mesh>(Renderer::Mesh::LoadFromObj(mesh_path));
+                if (m_meshCache.find(mesh_path) == m_meshCache.end()) {
+                    m_meshCache[mesh_path] = pending_meshes.at(mesh_path).get();
                 }
-                obj.mesh = scene.m_meshCache[mesh_path];
+                obj.mesh = m_meshCache[mesh_path];
 
                 // ӻMaterial
                 std::string mat_name = obj_data["material"];
-                if (scene.m_materialCache.find(mat_name) != scene.m_materialCache.end()) {
-                    obj.material = scene.m_materialCache[mat_name];
+                if (m_materialCache.find(mat_name) != m_materialCache.end()) {
+                    obj.material = m_materialCache[mat_name];
                 }
 
-                scene.m_objects.push_back(obj);
+                m_objects.push_back(obj);
             }
         }
 
@@ -195,16 +324,155 @@ namespace Morpheus::Scene {
             for (const auto& light_data : data["lights"]) {
                 if (light_data["type"] == "directional") {
                     DirectionalLight light;
-                    light.direction = { light_data["direction"][0], light_data["direction"][1], light_data["direction"][2] };
-                    // öԷйһ
+                    // ɫֱʹ÷򣬲ÿƬԪһ
+                    light.direction = Math::normalize(Math::Vector3f{ light_data["direction"][0], light_data["direction"][1], light_data["direction"][2] });
+                    light.color = { light_data["color"][0], light_data["color"][1], light_data["color"][2] };
+                    light.intensity = light_data["intensity"];
+                    m_directionalLights.push_back(light);
+                }
+                else if (light_data["type"] == "point") {
+                    PointLight light;
+                    light.position = { light_data["position"][0], light_data["position"][1], light_data["position"][2] };
                     light.color = { light_data["color"][0], light_data["color"][1], light_data["color"][2] };
                     light.intensity = light_data["intensity"];
-                    scene.m_directionalLights.push_back(light);
+                    light.range = light_data["range"];
+                    m_pointLights.push_back(light);
+                }
+                else if (light_data["type"] == "spot") {
+                    // ׶ڳļǽǶƵİ
+                    constexpr float DEG_TO_RAD = 3.14159265f / 180.0f;
+                    SpotLight light;
+                    light.position = { light_data["position"][0], light_data["position"][1], light_data["position"][2] };
+                    light.direction = Math::normalize(Math::Vector3f{ light_data["direction"][0], light_data["direction"][1], light_data["direction"][2] });
+                    light.color = { light_data["color"][0], light_data["color"][1], light_data["color"][2] };
+                    light.intensity = light_data["intensity"];
+                    light.range = light_data["range"];
+                    light.outerConeAngle = (float)light_data["outer_cone_angle"] * DEG_TO_RAD;
+                    light.innerConeAngle = light_data.contains("inner_cone_angle") ?
+                        std::min((float)light_data["inner_cone_angle"] * DEG_TO_RAD, light.outerConeAngle) : light.outerConeAngle;
+                    m_spotLights.push_back(light);
+                }
+                else {
+                    SDL_Log("Skipping light with unknown type '%s'", light_data["type"].get<std::string>().c_str());
                 }
             }
         }
+    }
 
-        std::cout << "Scene loaded. " << scene.m_objects.size() << " objects." << std::endl;
-        return scene;
+    // ---  ---
+    // жһ̨ǷѾ ()
+    template<typename T>
+    bool IsReady(const std::future<T>& future) {
+        return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    void Scene::EnableHotReload() {
+        if (!m_watcher) {
+            m_watcher = std::make_unique<Core::FileWatcher>();
+        }
+        WatchAssets();
+    }
+
+    void Scene::WatchAssets() {
+        if (!m_sourcePath.empty()) m_watcher->Watch(m_sourcePath);
+        for (const auto& [path, mesh] : m_meshCache) m_watcher->Watch(path);
+        for (const auto& [path, texture] : m_textureCache) m_watcher->Watch(path);
+    }
+
+    bool Scene::PollHotReload() {
+        if (!m_watcher) return false;
+
+        // 1. ΪĶļύ̨Ⱦᱻ
+        // ͬһļһػûʱظύ
+        auto& pool = Core::ThreadPool::Get();
+        for (const std::string& path : m_watcher->Poll()) {
+            if (path == m_sourcePath) {
+                if (m_pendingSceneReload.valid()) continue;
+                m_pendingSceneReload = pool.Submit([path]() {
+                    return std::make_shared<json>(LoadSceneDocument(path));
+                    });
+            }
+            else if (m_meshCache.count(path)) {
+                if (m_pendingMeshReloads.count(path)) continue;
+                m_pendingMeshReloads[path] = pool.Submit([path]() {
+                    return std::make_shared<Renderer::Mesh>(Renderer::Mesh::Load(path));
+                    });
+            }
+            else if (m_textureCache.count(path)) {
+                if (m_pendingTextureReloads.count(path)) continue;
+                m_pendingTextureReloads[path] = pool.Submit([path]() {
+                    return Renderer::Texture::Load(path);
+                    });
+            }
+            SDL_Log("Hot reload: '%s' changed, reloading.", path.c_str());
+        }
+
+        // 2. ѾɵԴ
+        // ֮֡䡢ִ߳УȾ̲߳ῴһĳʧʱԴ
+        bool changed = false;
+
+        for (auto it = m_pendingMeshReloads.begin(); it != m_pendingMeshReloads.end();) {
+            if (!IsReady(it->second)) { ++it; continue; }
+            try {
+                auto new_mesh = it->second.get();
+                auto old_mesh = m_meshCache[it->first];
+                m_meshCache[it->first] = new_mesh;
+                for (auto& obj : m_objects) {
+                    if (obj.mesh == old_mesh) obj.mesh = new_mesh;
+                }
+                changed = true;
+            }
+            catch (const std::exception& e) {
+                SDL_Log("Hot reload: Failed to reload mesh '%s': %s", it->first.c_str(), e.what());
+            }
+            it = m_pendingMeshReloads.erase(it);
+        }
+
+        for (auto it = m_pendingTextureReloads.begin(); it != m_pendingTextureReloads.end();) {
+            if (!IsReady(it->second)) { ++it; continue; }
+            auto new_texture = it->second.get();
+            if (new_texture) {
+                auto old_texture = m_textureCache[it->first];
+                m_textureCache[it->first] = new_texture;
+                // 干ģĲָ͵¹ʹ
+                for (auto& [name, mat] : m_materialCache) {
+                    if (mat->albedo_texture == old_texture) mat->albedo_texture = new_texture;
+                    if (mat->normal_texture == old_texture) mat->normal_texture = new_texture;
+                }
+                changed = true;
+            }
+            else {
+                SDL_Log("Hot reload: Keeping previous version of texture '%s'.", it->first.c_str());
+            }
+            it = m_pendingTextureReloads.erase(it);
+        }
+
+        // ļˣؽʡ͵ƹ⣬߻棬ֻõԴŻᱻ
+        // ǰ״̬سļĳʼλ
+        if (IsReady(m_pendingSceneReload)) {
+            Camera camera = m_camera;
+            auto objects = m_objects;
+            auto lights = m_directionalLights;
+            auto point_lights = m_pointLights;
+            auto spot_lights = m_spotLights;
+            auto materials = m_materialCache;
+            try {
+                Build(*m_pendingSceneReload.get());
+                WatchAssets();
+                changed = true;
+            }
+            catch (const std::exception& e) {
+                // ļдˣص֮ǰ״̬
+                SDL_Log("Hot reload: Failed to reload scene '%s': %s", m_sourcePath.c_str(), e.what());
+                m_objects = std::move(objects);
+                m_directionalLights = std::move(lights);
+                m_pointLights = std::move(point_lights);
+                m_spotLights = std::move(spot_lights);
+                m_materialCache = std::move(materials);
+            }
+            m_camera = camera;
+        }
+
+        return changed;
     }
 }
@@ -7,6 +7,9 @@
 #include <string>
 #include <map>
 #include <functional>
+#include <memory>
+#include <future>
+#include "../core/FileWatcher.h"
 
 // ǰnlohmann::json
 #include <nlohmann/json_fwd.hpp>
@@ -17,8 +20,10 @@ namespace Morpheus::Scene {
 
     class Scene {
     public:
-        // һJSONļس
+        // һJSONļس (Ҳ .msgpack / .cbor ʽĶƳ)
         static Scene Load(const std::string& filepath);
+        // ѳĵдɶƿգչѡ CBOR (.cbor)  MessagePack ()
+        static void WriteSnapshot(const nlohmann::json& data, const std::string& snapshotPath);
 
         // --- Getters ---
         Camera& GetCamera(){ return m_camera; }
@@ -27,12 +32,26 @@ namespace Morpheus::Scene {
         // --- һ̬ע Shader ---
         static void RegisterShader(const std::string& name, std::function<std::shared_ptr<Renderer::IShader>()> factoryFn);
         const std::vector<DirectionalLight>& GetDirectionalLights() const { return m_directionalLights; }
+        const std::vector<PointLight>& GetPointLights() const { return m_pointLights; }
+        const std::vector<SpotLight>& GetSpotLights() const { return m_spotLights; }
+
+        // ---  ---
+        // ʼӳļԼѼص
+        void EnableHotReload();
+        // ֮֡ ()ΪĶļύ̨
+        // ѾɵԴ桢¹ǵĲʺ塣Դ滻ʱ true
+        bool PollHotReload();
     private:
         Scene() = default;
 
+        void Build(const nlohmann::json& data);
+        void WatchAssets();
+
         Camera m_camera;
         std::vector<SceneObject> m_objects;
         std::vector<DirectionalLight> m_directionalLights;
+        std::vector<PointLight> m_pointLights;
+        std::vector<SpotLight> m_spotLights;
 
         // Դ棬ֹظ
         std::map<std::string, std::shared_ptr<Renderer::Mesh>> m_meshCache;
@@ -45,5 +64,13 @@ namespace Morpheus::Scene {
         // Shader (e.g., "Unlit", "PBR")
         // ֵһܴӦShaderʵĺ
         static std::map<std::string, std::function<std::shared_ptr<Renderer::IShader>()>> s_shaderFactory;
+
+        // --- ״̬ ---
+        std::string m_sourcePath;
+        std::unique_ptr<Core::FileWatcher> m_watcher;
+        // ں̨¼صԴļ·
+        std::map<std::string, std::future<std::shared_ptr<Renderer::Mesh>>> m_pendingMeshReloads;
+        std::map<std::string, std::future<std::shared_ptr<Renderer::Texture>>> m_pendingTextureReloads;
+        std::future<std::shared_ptr<nlohmann::json>> m_pendingSceneReload;
     };
 }
@@ -16,6 +16,8 @@ namespace Morpheus::Scene {
         Math::Matrix4f transform; // ģͱ任
         std::shared_ptr<Renderer::Mesh> mesh;
         std::shared_ptr<Renderer::Material> material;
+        // ̬岻ƶ (ļ "static": true)ȾԿ֡ǵӰ
+        bool isStatic = false;
         
         SceneObject() : transform(Math::Matrix4f::Identity()) {}
     };